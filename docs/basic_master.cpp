@@ -0,0 +1,56 @@
+// BasicMaster has the operations of MasterConfig, each feature is a policy selected at compile time
+// and the "No" policies generate no code (MasterConfig is BasicMaster with every policy set at runtime)
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+// Peripheral settings
+constexpr uint8_t peripheralAddress = 0xB;
+
+using namespace TwoWire::MasterPolicy;
+
+// -- Policies --
+// Timeout:         NoTimeout (only TWINT is polled), FixedTimeout<us>, RuntimeTimeout (setTimeout, disableTimeout)
+// Bus lost:        FixedBusLost<BusLostBehaviour::...>, RuntimeBusLost (setBusLostBehaviour)
+// Errors:          NoRetry (the bus is released and the status returned),
+//                  RuntimeRetry (setRetryPolicy, getAttempts, setSlaveHandler, setBusRecovery)
+// Instrumentation: NoInstrumentation, StatisticsInstrumentation (see docs/statistics.cpp)
+
+// Smallest master (same as BasicMaster<NoTimeout, FixedBusLost<BusLostBehaviour::Abort>, NoRetry, NoInstrumentation>)
+TwoWire::BasicMaster<> lean;
+
+// Fixed timeout, retry on bus lost within it (set with setRetryPolicy, bus lost is retried by default)
+TwoWire::BasicMaster<FixedTimeout<10000>, FixedBusLost<BusLostBehaviour::RetryWithinTimeout>, RuntimeRetry> robust;
+
+// Same as TwoWire::MasterConfig
+TwoWire::BasicMaster<RuntimeTimeout, RuntimeBusLost, RuntimeRetry, StatisticsInstrumentation> full{25000, BusLostBehaviour::Abort};
+
+void setup()
+{
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    uint8_t data[2] = {0x3, 0x5};
+
+    // Operations are the same as the ones of MasterConfig (see docs/master_basic.cpp)
+    if (lean.send(peripheralAddress, data, sizeof(data)) != TwoWire::MStatus::Success)
+    {
+        // first failure is returned (bus is already released)
+    }
+    lean.receiveRegister(peripheralAddress, 0x0, data, sizeof(data), true);
+    lean.writeRegister<2, TwoWire::MByteOrder::BigEndian>(peripheralAddress, 0x1234, data, sizeof(data));
+
+    // Deadline given by the caller works with every timeout policy
+    TwoWire::Deadline deadline{5000};
+    lean.probe(peripheralAddress, true, deadline);
+
+    // Runtime policies keep their setters
+    robust.setRetryPolicy({3, robust.retryOn(TwoWire::MStatus::BusLost), TwoWire::MBackoff::Fixed, 100});
+    full.setTimeout(35000);
+    full.setBusLostBehaviour(BusLostBehaviour::RetryExtendingTimeout);
+}
+
+void loop()
+{
+}
@@ -0,0 +1,70 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+// Peripheral settings
+constexpr uint8_t peripheralAddress = 0xB;
+
+// Pulses at the bus frequency, internal pull-ups are used (false with external pull-ups only)
+TwoWire::BusRecovery recovery{twoWireFrequency, true};
+// or (100 kHz, external pull-ups)
+TwoWire::BusRecovery recovery2{};
+
+void setup()
+{
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+    TwoWire::activatePullup();
+
+    auto m = TwoWire::MasterConfig(5000);
+
+    // -- Automatic recovery --
+
+    // After Timeout or Error the bus is recovered if a line is held low
+    m.setBusRecovery(&recovery);
+    // retry the operation once the bus is free
+    m.setRetryPolicy({2, m.retryOn(TwoWire::MStatus::Timeout) | m.retryOn(TwoWire::MStatus::Error),
+        TwoWire::MBackoff::None, 0});
+    // disable
+    m.setBusRecovery(nullptr);
+
+    // -- Manual recovery --
+
+    // Whether some device holds SCL or SDA low
+    if (!TwoWire::BusRecovery::isBusIdle())
+    {
+        // Clock out up to 9 pulses and STOP (TWI address, frequency and control settings are kept)
+        auto report = recovery.recover();
+        switch (report.result)
+        {
+        case TwoWire::RResult::Recovered:
+            // bus is free
+            break;
+        case TwoWire::RResult::ClockHeld:
+            // some device stretches SCL forever (power cycle it)
+            break;
+        case TwoWire::RResult::DataHeld:
+            // SDA is still low after the pulses
+            break;
+        }
+        // report.pulses: SCL pulses clocked out, report.dataWasHeld: whether SDA was held before the recovery,
+        // report.duration: duration in microseconds
+        if (report.dataWasHeld && report.pulses == TwoWire::BusRecovery::MAX_PULSES)
+        {
+            // slave needed every pulse (it was interrupted at the start of a byte)
+        }
+    }
+
+    // Report of the last (possibly automatic) recovery
+    recovery.getLastReport();
+    // Number of recoveries
+    recovery.getRecoveryCount();
+
+    // Use the bus
+    m.send(peripheralAddress, 0x1);
+}
+
+void loop()
+{
+}
@@ -184,6 +184,36 @@ void setup()
 
     //
 
+    // -- Deadline across steps --
+
+    // Every command above has its own timeout, a deadline bounds the whole sequence
+    TwoWire::Deadline deadline{twoWireTimeout};
+    if (m.signalStart(deadline) != TwoWire::MStatus::Success)
+    {
+        // something is wrong (necessary to handle)
+    }
+    if (m.addressForWriting(peripheralAddress, deadline) != TwoWire::MStatus::Success)
+    {
+        // something is wrong (necessary to handle)
+    }
+    if (m.sendData(data, sizeof(data), deadline) != TwoWire::MStatus::Success)
+    {
+        // something is wrong (necessary to handle)
+    }
+    TwoWire::signalStop();
+    // Budget left after the steps (in microseconds)
+    deadline.getRemaining();
+    // or check it
+    deadline.isExpired();
+
+    // MasterConfig operations accept it too (retries never extend it)
+    auto m3 = TwoWire::MasterConfig(twoWireTimeout);
+    TwoWire::Deadline slot{2000};
+    m3.send(peripheralAddress, data, sizeof(data), true, slot);
+    m3.receiveRegister(peripheralAddress, peripheralReceiveRegister, data, sizeof(data), peripheralSupportsRepeatedStart, true, slot);
+
+    //
+
     // Make it look like TWI wasnt here
     TwoWire::deactivatePullup();
     TwoWire::disable();
@@ -0,0 +1,84 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+// Peripheral settings
+constexpr uint8_t peripheralAddress = 0xB;
+constexpr uint8_t peripheralRegister = 0xC;
+// Whether the peripheral supports I2C repeated start (set to true if you dont know)
+constexpr bool peripheralSupportsRepeatedStart = true;
+
+uint8_t sendBuffer[2] = {peripheralRegister, 0x2}; // can be of any size
+uint8_t receiveBuffer[2]; // can be of any size
+
+volatile bool transactionFinished = false;
+
+TwoWire::MasterAsync m{};
+// or with a queue (transactions are started back-to-back from the interrupt)
+TwoWire::MasterAsync::Transaction queue[12];
+TwoWire::MasterAsync m2{queue, sizeof(queue) / sizeof(queue[0])};
+
+ISR(TWI_vect)
+{
+    if (!m.interruptVectorRoutine())
+    {
+        // Interrupt was not for the master (lost arbitration and addressed as slave)
+        // pass it to the slave routines here
+    }
+}
+
+// Called from the TWI interrupt (keep it short)
+void onFinished(TwoWire::MStatus s, void *context)
+{
+    transactionFinished = true;
+}
+
+void setup()
+{
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    // Pullup has to be manually activated for compatibility with 3.3V devices
+    TwoWire::activatePullup();
+
+    // Buffers have to stay valid until the transaction finishes
+
+    // -- Send --
+    m.send(peripheralAddress, sendBuffer, sizeof(sendBuffer));
+    // or keep the bus (next transaction starts with repeated start)
+    m.send(peripheralAddress, sendBuffer, sizeof(sendBuffer), false);
+    // or get notified on completion
+    m.send(peripheralAddress, sendBuffer, sizeof(sendBuffer), true, onFinished, nullptr);
+
+    // -- Receive --
+    m.receive(peripheralAddress, receiveBuffer, sizeof(receiveBuffer));
+
+    // -- Receive register --
+    m.receiveRegister(peripheralAddress, peripheralRegister, receiveBuffer, sizeof(receiveBuffer), peripheralSupportsRepeatedStart);
+
+    // All of the functions return false when another transaction is in progress (and the queue is full)
+    while (!m.send(peripheralAddress, sendBuffer, sizeof(sendBuffer)))
+    {
+    }
+}
+
+void loop()
+{
+    // Resume the queue after the master was addressed as slave
+    m2.resume();
+
+    // Poll for transaction finished
+    if (!m.isBusy())
+    {
+        if (m.getStatus() != TwoWire::MStatus::Success)
+        {
+            // something is wrong (unnecessary to handle)
+        }
+    }
+    // or use callback
+    if (transactionFinished)
+    {
+        transactionFinished = false;
+    }
+}
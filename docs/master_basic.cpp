@@ -10,6 +10,10 @@ void setup()
 {
     // Initialize TWI hardware
     TwoWire::init(twoWireAddress, twoWireFrequency);
+    // or plan frequency at compile time (fails to compile if the frequency is not achievable)
+    TwoWire::init<twoWireFrequency>(twoWireAddress);
+    // change frequency later
+    TwoWire::setFrequency<400000>();
 
     // Pullup has to be manually activated for compatibility with 3.3V devices
     TwoWire::activatePullup();
@@ -26,6 +30,9 @@ void setup()
     m.setTimeout();
     // set bus lost behaviour
     m.setBusLostBehaviour(twoWireBusLostBehaviour);
+    // set retry policy (at most 5 attempts, retry on bus lost and address NACK, exponential backoff from 100 us)
+    m.setRetryPolicy({5, m.retryOn(TwoWire::MStatus::BusLost) | m.retryOn(TwoWire::MStatus::AddressNACK),
+        TwoWire::MBackoff::Exponential, 100});
 
     // Peripheral settings
     constexpr uint8_t peripheralAddress = 0xB;
@@ -83,6 +90,38 @@ void setup()
         // something is wrong (unnecessary to handle)
     }
 
+    // - Easy way -
+    if (m.writeRegister(peripheralAddress, peripheralSendRegister, data, sizeof(data)) != TwoWire::MStatus::Success)
+    {
+        // something is wrong (unnecessary to handle)
+    }
+
+    // - Register with 16 bit address (size and byte order are chosen at compile time) -
+    if (m.writeRegister<2, TwoWire::MByteOrder::BigEndian>(peripheralAddress, 0x1234, data, sizeof(data))
+        != TwoWire::MStatus::Success)
+    {
+        // something is wrong (unnecessary to handle)
+    }
+
+    // - Write to register without copying (segments are sent in one transaction) -
+    constexpr uint8_t registerAddress = peripheralSendRegister;
+    const TwoWire::MSendSegment sendSegments[] = {{&registerAddress, 1}, {data, sizeof(data)}};
+    if (m.send(peripheralAddress, sendSegments, 2) != TwoWire::MStatus::Success)
+    {
+        // something is wrong (unnecessary to handle)
+    }
+
+    //
+
+    // -- Receive into multiple buffers --
+
+    uint8_t header;
+    const TwoWire::MReceiveSegment receiveSegments[] = {{&header, 1}, {data, sizeof(data)}};
+    if (m.receive(peripheralAddress, receiveSegments, 2) != TwoWire::MStatus::Success)
+    {
+        // something is wrong (unnecessary to handle)
+    }
+
     //
 
     // -- Read from register --
@@ -94,6 +133,13 @@ void setup()
         // something is wrong (unnecessary to handle)
     }
 
+    // - Register with 16 bit address (1, 2 or 4 bytes in big or little endian) -
+    if (m.receiveRegister<2, TwoWire::MByteOrder::LittleEndian>(peripheralAddress, 0x1234, data, sizeof(data),
+        peripheralSupportsRepeatedStart) != TwoWire::MStatus::Success)
+    {
+        // something is wrong (unnecessary to handle)
+    }
+
     // - Difficult way -
     if (m.send(peripheralAddress, peripheralReceiveRegister, !peripheralSupportsRepeatedStart)
         != TwoWire::MStatus::Success)
@@ -0,0 +1,41 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 400000;
+
+TwoWire::MasterConfig m{};
+TwoWire::MemoryDevice eeprom{m, 0x50, 2, 64};
+
+// 4 lines of 64 bytes (line size equal to the page size flushes every line as one page write)
+uint8_t storage[TwoWire::MemoryCache::getStorageSize(64, 4)];
+TwoWire::MemoryCache::Line lines[4];
+TwoWire::MemoryCache cache{eeprom, storage, lines, 4, 64};
+
+void setup()
+{
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    uint8_t data[4];
+
+    // Read through the cache (only the first read of a line uses the bus)
+    if (cache.read(0x0010, data, sizeof(data)) != TwoWire::MStatus::Success)
+    {
+        // something is wrong (unnecessary to handle)
+    }
+
+    // Write through the cache (kept in RAM, writes to the same line are coalesced)
+    cache.write(0x0012, data, 2);
+    cache.write(0x0014, data, 2);
+
+    // Write modified lines to the memory (also done when a modified line is replaced)
+    if (cache.isDirty())
+        cache.flush();
+
+    // Drop cached contents (e.g. the memory was changed by someone else, flush first to keep the writes)
+    cache.invalidate();
+}
+
+void loop()
+{
+}
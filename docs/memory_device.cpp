@@ -0,0 +1,50 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 400000;
+
+TwoWire::MasterConfig m{};
+
+// 24C256 EEPROM: 2 byte memory address, 64 byte pages
+TwoWire::MemoryDevice eeprom{m, 0x50, 2, 64};
+// or with explicit write cycle timeout in microseconds
+TwoWire::MemoryDevice eeprom2{m, 0x50, 2, 64, 5000};
+// 24C16 EEPROM: 1 byte memory address (upper 3 bits go to the device address), 16 byte pages
+TwoWire::MemoryDevice eeprom3{m, 0x50, 1, 16};
+// FRAM: no pages and no write cycle
+TwoWire::MemoryDevice fram{m, 0x50, 2, 0};
+// or driven by any other master
+TwoWire::BasicMaster<> small{};
+TwoWire::BasicMemoryDevice<TwoWire::BasicMaster<>> eeprom4{small, 0x50, 2, 64};
+
+void setup()
+{
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    uint8_t data[100];
+
+    // Write any length at any address (split on page boundaries, next page is written as soon as the memory acknowledges)
+    if (eeprom.write(0x0123, data, sizeof(data)) != TwoWire::MStatus::Success)
+    {
+        // something is wrong (unnecessary to handle)
+    }
+
+    // Read any length in a single transaction (waits for the write cycle first)
+    if (eeprom.read(0x0123, data, sizeof(data)) != TwoWire::MStatus::Success)
+    {
+        // something is wrong (unnecessary to handle)
+    }
+
+    // Check write cycle without blocking
+    eeprom.isReady();
+    // or wait for it
+    eeprom.awaitReady();
+
+    // Probe any device (SLA+W only)
+    m.probe(0x50);
+}
+
+void loop()
+{
+}
@@ -0,0 +1,75 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+// Peripheral settings
+constexpr uint8_t peripheralAddress = 0xB;
+constexpr uint8_t peripheralRegister = 0xC;
+
+uint8_t receiveBuffer[2];
+uint8_t slaveBuffer[8];
+
+// Master and slave role share the TWI
+TwoWire::MasterAsync m{};
+TwoWire::SlaveReceiver s{slaveBuffer, sizeof(slaveBuffer)};
+
+// Lost transactions are restarted at most 4 times (any slave handler, SlaveDispatcher too)
+TwoWire::ArbitrationManager a{m, TwoWire::SlaveDispatcher::handler(s), 4};
+
+ISR(TWI_vect)
+{
+    a.interruptVectorRoutine(); // instead of m.interruptVectorRoutine() and s.interruptVectorRoutine()
+}
+
+// Blocking master can serve the slave role as well
+TwoWire::MasterConfig blocking{};
+
+void setup()
+{
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    // Enable interrupt for ISR
+    TwoWire::enableInterrupt();
+
+    // Start transaction, when addressed by the master who won the bus it's suspended
+    // and resumed (before the queued ones) once the slave transaction ends
+    m.receiveRegister(peripheralAddress, peripheralRegister, receiveBuffer, sizeof(receiveBuffer), true);
+
+    // Whether a transaction waits for the slave transaction to end
+    m.isSuspended();
+
+    // Arbitration statistics
+    auto statistics = a.getStatistics();
+    statistics.arbitrationLost;   // bus lost to another master
+    statistics.addressedAsSlave;  // addressed while transmitting
+    statistics.slaveTransactions; // slave transactions served
+    statistics.resumed;           // transactions resumed after a slave transaction
+    a.resetStatistics();
+
+    // -- Blocking master --
+
+    // Serve the slave transaction by polling, then restart the operation within the attempt limit
+    // of the retry policy and the timeout (TWI interrupt must be disabled)
+    TwoWire::disableInterrupt();
+    blocking.setSlaveHandler(TwoWire::SlaveDispatcher::handler(s));
+    // report AddressedAsSlave instead
+    blocking.setSlaveHandler(TwoWire::SlaveDispatcher::none());
+}
+
+void loop()
+{
+    if (!m.isBusy() && !m.isSuspended())
+    {
+        // Use data
+        receiveBuffer[0];
+    }
+    if (s.isDataAvailable())
+    {
+        // Use data
+        slaveBuffer[0];
+
+        s.receiveNextData();
+    }
+}
@@ -0,0 +1,49 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 400000;
+
+constexpr uint8_t sensorAddress = 0x68;
+
+TwoWire::MasterConfig m{};
+
+uint8_t registers[0x40]; // can be of any size up to 256
+uint8_t valid[TwoWire::RegisterCache::getMaskSize(sizeof(registers))]; // bit per register
+uint8_t dirty[TwoWire::RegisterCache::getMaskSize(sizeof(registers))]; // bit per register
+const uint8_t volatileMask[TwoWire::RegisterCache::getMaskSize(sizeof(registers))] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00}; // registers 0x30-0x37
+
+TwoWire::RegisterCache sensor{m, sensorAddress, registers, sizeof(registers), valid, dirty};
+// or
+TwoWire::RegisterCache sensor2{m, sensorAddress, registers, sizeof(registers), valid, dirty, volatileMask};
+
+void setup()
+{
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    // Registers changed by the device itself (status, measurements) are never cached
+    sensor.setVolatileMask(volatileMask);
+
+    // Change bits (register is read once, later changes are served from the cache)
+    sensor.updateBits(0x10, 0x07, 0x03);
+    sensor.updateBits(0x10, 0x80, 0x80);
+    sensor.updateBits(0x11, 0xFF, 0x42);
+    // or write whole register
+    sensor.write(0x12, 0x01);
+
+    // Write changed registers (0x10-0x12 in a single transaction)
+    if (sensor.sync() != TwoWire::MStatus::Success)
+    {
+        // something is wrong (unnecessary to handle)
+    }
+
+    // Drop cached values (e.g. after the device was reset)
+    sensor.invalidate();
+}
+
+void loop()
+{
+    // Volatile registers are read from the device
+    uint8_t status;
+    sensor.read(0x30, &status);
+}
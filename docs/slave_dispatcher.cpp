@@ -0,0 +1,55 @@
+#include <TwoWire.hpp>
+
+constexpr uint32_t twoWireFrequency = 100000;
+
+uint8_t registers[16];
+TwoWire::SlaveRegisterMap registerMap{registers, sizeof(registers)};
+uint8_t buffer[8];
+TwoWire::SlaveReceiver receiver{buffer, sizeof(buffer)};
+const uint8_t data[4] = {1, 2, 3, 4};
+TwoWire::SlaveTransmitter transmitter{data, sizeof(data)};
+
+// Handler per address starting at the base address (any class with interruptVectorRoutine)
+const TwoWire::SlaveDispatcher::Handler handlers[] = {
+    TwoWire::SlaveDispatcher::handler(registerMap), // 0x20
+    TwoWire::SlaveDispatcher::handler(receiver),    // 0x21
+    TwoWire::SlaveDispatcher::handler(transmitter), // 0x22
+    TwoWire::SlaveDispatcher::none(),               // 0x23 doesn't answer
+};
+
+TwoWire::SlaveDispatcher d{0x20, handlers, 4};
+
+// Address mask can be computed at compile time
+constexpr uint8_t mask = TwoWire::SlaveDispatcher::getAddressMask(0x20, 4); // 0x03
+
+ISR(TWI_vect)
+{
+    d.interruptVectorRoutine(); // routes the transaction to the handler of the matched address
+}
+
+void setup()
+{
+    // Initialize TWI hardware
+    TwoWire::init(0x20, twoWireFrequency);
+
+    // Accept the whole address range (sets TWAR and TWAMR)
+    d.setAddresses();
+
+    // Enable interrupt for ISR
+    TwoWire::enableInterrupt();
+}
+
+void loop()
+{
+    // Use the slave objects as if each had its own TWI
+    if (receiver.isDataAvailable())
+    {
+        // Use data
+        buffer[0];
+
+        receiver.receiveNextData();
+    }
+
+    // Address of the transaction in progress (0 if none)
+    d.getActiveAddress();
+}
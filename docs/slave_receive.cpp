@@ -6,12 +6,17 @@ constexpr uint32_t twoWireFrequency = 100000;
 uint8_t receiveVariable;
 uint8_t receiveBuffer[2]; // can be of any size
 uint8_t secondReceiveBuffer[3]; // can be of any size
+uint8_t pingBuffer[8];
+uint8_t pongBuffer[8];
+TwoWire::SlaveReceiver::Buffer buffers[] = {{pingBuffer, sizeof(pingBuffer)}, {pongBuffer, sizeof(pongBuffer)}}; // two or more
 
 TwoWire::SlaveReceiver r{};
 // or
 TwoWire::SlaveReceiver r2{&receiveVariable};
 // or
 TwoWire::SlaveReceiver r3{receiveBuffer, sizeof(receiveBuffer)};
+// or
+TwoWire::SlaveReceiver r4{buffers, 2}; // next buffer is filled while the completed one is processed
 
 ISR(TWI_vect)
 {
@@ -32,14 +37,16 @@ void setup()
 
 void loop()
 {
-    // Poll for data received
+    // Poll for data received (buffer is filled, with multiple buffers also when master sent STOP)
     if (r.isDataAvailable())
     {
         // Use data
         receiveBuffer;
+        r.getData(); // completed buffer (useful with multiple buffers)
+        r.getDataSize(); // number of bytes received
 
         // Receive more
-        r.receiveNextData(); // same location
+        r.receiveNextData(); // same location (with multiple buffers releases the completed one)
         // or
         r.receiveNextData(secondReceiveBuffer, sizeof(secondReceiveBuffer)); // different location
     }
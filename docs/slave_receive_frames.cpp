@@ -0,0 +1,52 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+uint8_t receiveRing[64]; // shared by all messages, one byte is kept free
+TwoWire::SlaveFrameReceiver::Frame frames[8]; // one descriptor per message, one is kept free
+
+TwoWire::SlaveFrameReceiver r{receiveRing, sizeof(receiveRing), frames, 8};
+
+ISR(TWI_vect)
+{
+    r.interruptVectorRoutine(); // most important part
+}
+
+void setup()
+{
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    // Enable general call to receive broadcast messages as well
+    TwoWire::allowGeneralCall();
+
+    // Enable interrupt for ISR
+    TwoWire::enableInterrupt();
+}
+
+void loop()
+{
+    // Poll for messages received (every STOP or repeated START ends a message)
+    // (data that doesn't fit the ring or the frame queue is NACKed)
+    if (r.isFrameAvailable())
+    {
+        // Message length
+        size_t size = r.getFrameSize();
+
+        // Message was broadcast
+        r.isGeneralCall();
+
+        // Message didn't fit the ring (only its beginning was received)
+        r.isTruncated();
+
+        // Use data in place
+        r.getFrameData(0);
+        // or
+        uint8_t message[16];
+        r.readFrame(message, sizeof(message)); // truncated to the storage size
+
+        // Receive more (interrupts stay enabled)
+        r.nextFrame();
+    }
+}
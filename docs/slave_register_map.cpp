@@ -0,0 +1,62 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+uint8_t registers[16]; // can be of any size up to 256
+uint8_t dirty[TwoWire::SlaveRegisterMap::getMaskSize(sizeof(registers))]; // bit per register
+const uint8_t readOnly[TwoWire::SlaveRegisterMap::getMaskSize(sizeof(registers))] = {0x0F, 0x00}; // registers 0x00-0x03
+const uint8_t writeOnly[TwoWire::SlaveRegisterMap::getMaskSize(sizeof(registers))] = {0x00, 0x80}; // register 0x0F
+
+TwoWire::SlaveRegisterMap m{registers, sizeof(registers)};
+// or
+TwoWire::SlaveRegisterMap m2{registers, sizeof(registers), dirty}; // track registers written by the master
+// or
+TwoWire::SlaveRegisterMap m3{registers, sizeof(registers), dirty, readOnly, writeOnly};
+
+ISR(TWI_vect)
+{
+    m.interruptVectorRoutine(); // most important part
+}
+
+void setup()
+{
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    // Enable interrupt for ISR
+    TwoWire::enableInterrupt();
+
+    // Setup access masks (if you havent done it with constructor or you want to change it)
+    m.setReadOnlyMask(readOnly); // writes are acknowledged and ignored
+    m.setWriteOnlyMask(writeOnly); // reads return 0xFF
+}
+
+void loop()
+{
+    // Master writes [register, data...] and reads [data...] from the register pointer
+    // (pointer auto-increments and wraps around at the end of the map)
+
+    // Update registers read by the master (disable interrupts for multi-byte values)
+    registers[0] = 0x12;
+
+    // Poll for registers written by the master
+    if (m2.isDirty())
+    {
+        for (uint8_t i = 0; i < sizeof(registers); i++)
+        {
+            if (m2.isDirty(i))
+            {
+                // Use data
+                registers[i];
+
+                m2.clearDirty(i);
+            }
+        }
+        // or
+        m2.clearDirty(); // all registers
+    }
+
+    // Register accessed next
+    m.getPointer();
+}
@@ -6,12 +6,34 @@ constexpr uint32_t twoWireFrequency = 100000;
 uint8_t trasmitVariable;
 uint8_t trasmitBuffer[2]; // can be of any size
 uint8_t secondTrasmitBuffer[3]; // can be of any size
+uint8_t trasmitChunk[4]; // can be of any size
+volatile uint16_t counter;
+uint8_t record[16];
+uint8_t snapshotStorage[TwoWire::SlaveTransmitter::getSnapshotStorageSize(16)]; // three 16 byte snapshots
+
+// Called from the ISR for every byte the master reads (index restarts at 0 with every read)
+uint8_t generateByte(size_t index, void *context)
+{
+    return index == 0 ? counter >> 8 : counter;
+}
+
+// Called from the ISR whenever the chunk buffer runs empty (return 0 to end the data)
+size_t generateChunk(uint8_t *data, size_t size, size_t index, void *context)
+{
+    for (size_t i = 0; i < size; i++)
+        data[i] = index + i;
+    return size;
+}
 
 TwoWire::SlaveTransmitter t{};
 // or
 TwoWire::SlaveTransmitter t2{&trasmitVariable, 1};
 // or
 TwoWire::SlaveTransmitter t3{trasmitBuffer, sizeof(trasmitBuffer)};
+// or
+TwoWire::SlaveTransmitter t4{generateByte, nullptr}; // data is computed when the master reads it
+// or
+TwoWire::SlaveTransmitter t5{generateChunk, trasmitChunk, sizeof(trasmitChunk), nullptr};
 
 ISR(TWI_vect)
 {
@@ -24,6 +46,8 @@ ISR(TWI_vect)
         t.transmitDataAgain(); // same data
         // or
         t.transmitData(secondTrasmitBuffer, sizeof(secondTrasmitBuffer)); // new data
+        // or
+        t.transmitGenerated(generateByte, nullptr); // generated data
     }
 }
 
@@ -37,10 +61,23 @@ void setup()
 
     // Setup slave receiver (if you havent done it with constructor or you want to change it)
     t.transmitData(trasmitBuffer, sizeof(trasmitBuffer));
+    // or
+    t2.transmitSnapshots(snapshotStorage, 16); // every read streams one consistent version
 }
 
 void loop()
 {
+    // Live state read by the generator
+    counter++;
+
+    // Publish new version of the data (no need to disable interrupts)
+    uint8_t *snapshot = t2.beginSnapshot();
+    snapshot[0] = counter >> 8;
+    snapshot[1] = counter;
+    t2.publishSnapshot(); // streamed from the next address match on
+    // or
+    t2.publishSnapshot(record); // copy whole snapshot
+
     // Poll for data trasmitted
     if (t.isDataTransmitted())
     {
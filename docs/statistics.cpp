@@ -0,0 +1,75 @@
+// Statistics are compiled in only if TWOWIRE_STATISTICS is defined for the whole build
+// (e.g. build_flags = -DTWOWIRE_STATISTICS in platformio.ini), without it every hook compiles to nothing
+// and the functions below don't exist
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+// Peripheral settings
+constexpr uint8_t peripheralAddress = 0xB;
+
+uint8_t buffer[8];
+TwoWire::SlaveReceiver s{buffer, sizeof(buffer)};
+
+ISR(TWI_vect)
+{
+    s.interruptVectorRoutine(); // slave routines count their transactions and bytes
+}
+
+void setup()
+{
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+    TwoWire::enableInterrupt();
+
+    // MasterConfig operations count transactions, bytes, retries and outcome per slave address
+    auto m = TwoWire::MasterConfig(25000);
+    uint8_t data[2];
+    m.receiveRegister(peripheralAddress, 0x0, data, sizeof(data), true);
+
+#ifdef TWOWIRE_STATISTICS
+    // -- Per slave address (TWOWIRE_STATISTICS_ADDRESSES addresses are tracked, 8 by default) --
+
+    TwoWire::Statistics::AddressStatistics a;
+    if (TwoWire::Statistics::getAddressStatistics(peripheralAddress, a))
+    {
+        a.transactions;                                   // number of operations
+        a.bytes;                                          // data bytes transferred
+        a.retries;                                        // repeated attempts
+        a.statuses[(uint8_t)TwoWire::MStatus::Timeout];   // operations that timed out
+        a.statuses[(uint8_t)TwoWire::MStatus::Success];   // successful operations
+    }
+    // addresses that didn't fit the table are counted together
+    TwoWire::Statistics::getAddressStatistics(TwoWire::Statistics::OTHER_ADDRESSES, a);
+    // iterate over the table
+    for (uint8_t i = 0; TwoWire::Statistics::getAddressStatisticsAt(i, a); i++)
+    {
+        a.address;
+    }
+
+    // -- Slave routines --
+
+    auto slave = TwoWire::Statistics::getSlaveStatistics();
+    slave.receptions;       // transactions as slave receiver
+    slave.transmissions;    // transactions as slave transmitter
+    slave.bytesReceived;
+    slave.bytesTransmitted;
+
+    // -- Latency histogram per transaction type (log2 buckets in microseconds) --
+
+    TwoWire::Statistics::Histogram h;
+    TwoWire::Statistics::getHistogram(TwoWire::Statistics::Transaction::ReceiveRegister, h);
+    // bucket 11 counts latencies from 1024 us below 2048 us
+    h.buckets[11];
+    // bucket of a latency
+    TwoWire::Statistics::getBucket(1500); // 11
+
+    // Reset all counters (getters copy atomically, so reading while the slave routine runs is safe)
+    TwoWire::Statistics::reset();
+#endif
+}
+
+void loop()
+{
+}
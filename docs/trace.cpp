@@ -0,0 +1,66 @@
+// The trace is compiled in only if TWOWIRE_TRACE is defined for the whole build
+// (e.g. build_flags = -DTWOWIRE_TRACE in platformio.ini), without it every hook compiles to nothing
+// and the functions below don't exist
+//
+// Optional settings (defined next to TWOWIRE_TRACE):
+//  TWOWIRE_TRACE_SIZE=64          events kept in the ring buffer (power of two, at most 256)
+//  TWOWIRE_TRACE_CLOCK()=...      16 bit timestamp source (Timer0 ticks of 4 us on 16 MHz by default)
+//  TWOWIRE_TRACE_TICK_NS=...      length of a timestamp tick when TWOWIRE_TRACE_CLOCK is changed
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+// Peripheral settings
+constexpr uint8_t peripheralAddress = 0xB;
+
+uint8_t buffer[8];
+TwoWire::SlaveReceiver s{buffer, sizeof(buffer)};
+
+ISR(TWI_vect)
+{
+    s.interruptVectorRoutine(); // every status seen by the slave routine is recorded
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+    TwoWire::enableInterrupt();
+
+    // MasterConfig records every status, requested STOPs and timeouts
+    auto m = TwoWire::MasterConfig(25000);
+    uint8_t data[2];
+    m.receiveRegister(peripheralAddress, 0x0, data, sizeof(data), true);
+
+#ifdef TWOWIRE_TRACE
+    // -- Dump for extras/trace/decode --
+
+    // copy first, printing is much slower than the bus (read copies atomically, oldest event first)
+    TwoWire::Trace::Event events[TWOWIRE_TRACE_SIZE];
+    size_t count = TwoWire::Trace::read(events, TWOWIRE_TRACE_SIZE);
+    Serial.print("# tick_ns=");
+    Serial.println((unsigned long)TwoWire::Trace::TICK_NS);
+    char line[16];
+    for (size_t i = 0; i < count; i++)
+    {
+        // status data time (hex)
+        snprintf(line, sizeof(line), "%02X %02X %04X", events[i].status, events[i].data, events[i].time);
+        Serial.println(line);
+    }
+    // save the output to a file and run: extras/trace/decode file
+
+    // -- Ring buffer --
+
+    // events recorded since clear (more than TWOWIRE_TRACE_SIZE means the oldest were overwritten)
+    TwoWire::Trace::getCount();
+    // start over
+    TwoWire::Trace::clear();
+#endif
+}
+
+void loop()
+{
+}
@@ -0,0 +1,48 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+// Peripheral settings
+constexpr uint8_t peripheralAddress = 0xB;
+constexpr uint8_t peripheralRegister = 0xC;
+
+uint8_t receiveBuffer[2];
+
+TwoWire::MasterAsync m{};
+
+ISR(TWI_vect)
+{
+    m.interruptVectorRoutine();
+}
+
+void setup()
+{
+    // Init serial
+    Serial.begin(9600);
+
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    // Start reading register (returns immediately)
+    m.receiveRegister(peripheralAddress, peripheralRegister, receiveBuffer, sizeof(receiveBuffer), true);
+}
+
+void loop()
+{
+    // Poll for transaction finished
+    if (!m.isBusy())
+    {
+        if (m.getStatus() == TwoWire::MStatus::Success)
+        {
+            Serial.write(receiveBuffer[0]);
+            Serial.write(receiveBuffer[1]);
+            Serial.println();
+        }
+
+        // Read again
+        m.receiveRegister(peripheralAddress, peripheralRegister, receiveBuffer, sizeof(receiveBuffer), true);
+    }
+
+    // Do other work while the TWI interrupt handles the transaction
+}
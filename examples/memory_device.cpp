@@ -0,0 +1,42 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 400000;
+
+constexpr uint8_t eepromAddress = 0x50;
+constexpr uint16_t eepromPageSize = 32; // 24C32
+
+struct Configuration
+{
+    uint32_t bootCount;
+    uint8_t name[40];
+};
+
+TwoWire::MasterConfig m{};
+TwoWire::MemoryDevice eeprom{m, eepromAddress, 2, eepromPageSize};
+
+void setup()
+{
+    // Setup serial
+    Serial.begin(9600);
+
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    // Load configuration
+    Configuration configuration;
+    if (eeprom.read(0, (uint8_t *)&configuration, sizeof(configuration)) != TwoWire::MStatus::Success)
+    {
+        Serial.println("EEPROM not found");
+        return;
+    }
+    configuration.bootCount++;
+    Serial.println(configuration.bootCount);
+
+    // Store configuration (returns once the last page is accepted, the write cycle ends in the background)
+    eeprom.write(0, (const uint8_t *)&configuration, sizeof(configuration));
+}
+
+void loop()
+{
+}
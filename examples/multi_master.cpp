@@ -0,0 +1,55 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+// Peripheral settings
+constexpr uint8_t peripheralAddress = 0xB;
+constexpr uint8_t peripheralRegister = 0xC;
+
+uint8_t receiveBuffer[2];
+uint8_t slaveBuffer[8];
+
+TwoWire::MasterAsync m{};
+TwoWire::SlaveReceiver s{slaveBuffer, sizeof(slaveBuffer)};
+TwoWire::ArbitrationManager a{m, TwoWire::SlaveDispatcher::handler(s)};
+
+ISR(TWI_vect)
+{
+    a.interruptVectorRoutine();
+}
+
+void setup()
+{
+    // Init serial
+    Serial.begin(9600);
+
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    // Enable interrupt for ISR
+    TwoWire::enableInterrupt();
+}
+
+void loop()
+{
+    // Read register whenever the previous read finished
+    if (!m.isBusy() && !m.isSuspended())
+    {
+        if (m.getStatus() == TwoWire::MStatus::Success)
+        {
+            Serial.write(receiveBuffer[0]);
+            Serial.write(receiveBuffer[1]);
+            Serial.println();
+        }
+        m.receiveRegister(peripheralAddress, peripheralRegister, receiveBuffer, sizeof(receiveBuffer), true);
+    }
+
+    // Poll for data written by the other master
+    if (s.isDataAvailable())
+    {
+        Serial.write(s.getData(), s.getDataSize());
+        Serial.println();
+        s.receiveNextData();
+    }
+}
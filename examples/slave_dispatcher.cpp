@@ -0,0 +1,51 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireBaseAddress = 0x20;
+constexpr uint32_t twoWireFrequency = 100000;
+
+// 0x20 configuration registers, 0x21 command input, 0x22 identification
+uint8_t registers[4];
+TwoWire::SlaveRegisterMap configuration{registers, sizeof(registers)};
+uint8_t command[4];
+TwoWire::SlaveReceiver commands{command, sizeof(command)};
+const uint8_t identification[] = {'T', 'W', '0', '1'};
+TwoWire::SlaveTransmitter identifier{identification, sizeof(identification)};
+
+const TwoWire::SlaveDispatcher::Handler devices[] = {
+    TwoWire::SlaveDispatcher::handler(configuration),
+    TwoWire::SlaveDispatcher::handler(commands),
+    TwoWire::SlaveDispatcher::handler(identifier),
+};
+
+TwoWire::SlaveDispatcher d{twoWireBaseAddress, devices, 3};
+
+ISR(TWI_vect)
+{
+    d.interruptVectorRoutine();
+}
+
+void setup()
+{
+    // Setup serial
+    Serial.begin(9600);
+
+    // Initialize TWI hardware
+    TwoWire::init(twoWireBaseAddress, twoWireFrequency);
+
+    // Answer at 0x20-0x22 (0x23 is matched by the mask and refused)
+    d.setAddresses();
+
+    // Enable interrupt for ISR
+    TwoWire::enableInterrupt();
+}
+
+void loop()
+{
+    // Poll for command received
+    if (commands.isDataAvailable())
+    {
+        Serial.write(commands.getData(), commands.getDataSize());
+        Serial.println();
+        commands.receiveNextData();
+    }
+}
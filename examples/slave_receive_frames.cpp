@@ -0,0 +1,41 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+uint8_t receiveRing[64];
+TwoWire::SlaveFrameReceiver::Frame frames[8];
+
+TwoWire::SlaveFrameReceiver r{receiveRing, sizeof(receiveRing), frames, 8};
+
+ISR(TWI_vect)
+{
+    r.interruptVectorRoutine();
+}
+
+void setup()
+{
+    // Setup serial
+    Serial.begin(9600);
+
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    // Enable interrupt for ISR
+    TwoWire::enableInterrupt();
+}
+
+void loop()
+{
+    // Poll for messages received
+    while (r.isFrameAvailable())
+    {
+        // Use data
+        for (size_t i = 0; i < r.getFrameSize(); i++)
+            Serial.write(r.getFrameData(i));
+        Serial.println();
+
+        // Receive more
+        r.nextFrame();
+    }
+}
@@ -0,0 +1,45 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+// 0x00-0x01 measurement (read only), 0x02 configuration
+uint8_t registers[3];
+uint8_t dirty[TwoWire::SlaveRegisterMap::getMaskSize(sizeof(registers))];
+const uint8_t readOnly[TwoWire::SlaveRegisterMap::getMaskSize(sizeof(registers))] = {0b011};
+
+TwoWire::SlaveRegisterMap m{registers, sizeof(registers), dirty, readOnly, nullptr};
+
+ISR(TWI_vect)
+{
+    m.interruptVectorRoutine();
+}
+
+void setup()
+{
+    // Setup serial
+    Serial.begin(9600);
+
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    // Enable interrupt for ISR
+    TwoWire::enableInterrupt();
+}
+
+void loop()
+{
+    // Update measurement
+    uint16_t measurement = analogRead(A0);
+    noInterrupts();
+    registers[0] = measurement >> 8;
+    registers[1] = measurement;
+    interrupts();
+
+    // Poll for configuration written
+    if (m.isDirty(2))
+    {
+        m.clearDirty(2);
+        Serial.println(registers[2]);
+    }
+}
@@ -0,0 +1,37 @@
+#include <TwoWire.hpp>
+
+constexpr uint8_t twoWireAddress = 0xA;
+constexpr uint32_t twoWireFrequency = 100000;
+
+volatile uint16_t average;
+
+uint8_t generateAverage(size_t index, void *)
+{
+    // Snapshot is taken at the moment the master reads
+    return index == 0 ? average >> 8 : average;
+}
+
+TwoWire::SlaveTransmitter t{generateAverage, nullptr};
+
+ISR(TWI_vect)
+{
+    t.interruptVectorRoutine();
+}
+
+void setup()
+{
+    // Initialize TWI hardware
+    TwoWire::init(twoWireAddress, twoWireFrequency);
+
+    // Enable interrupt for ISR
+    TwoWire::enableInterrupt();
+}
+
+void loop()
+{
+    // Running filter output
+    uint16_t value = (average * 7 + analogRead(A0)) / 8;
+    noInterrupts();
+    average = value;
+    interrupts();
+}
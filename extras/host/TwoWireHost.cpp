@@ -0,0 +1,629 @@
+#include "TwoWireHost.hpp"
+
+#include <Arduino.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+using namespace TwoWire;
+
+extern "C" void TWI_vect(void) __attribute__((weak));
+
+namespace
+{
+    enum class Mode : uint8_t
+    {
+        Idle,
+        MasterStarted,
+        MasterTransmitter,
+        MasterReceiver,
+        SlaveReceiver,
+        SlaveTransmitter
+    };
+
+    struct Peripheral
+    {
+        // TWCR without TWINT
+        uint8_t control;
+        // TWINT flag
+        bool interrupt;
+        uint8_t status;
+        uint8_t prescaler;
+        uint8_t data;
+        uint8_t address;
+        uint8_t addressMask;
+        uint8_t bitRate;
+        Mode mode;
+        Host::Device *device;
+        bool arbitrationLoss;
+        // Operation requested by clearing TWINT is in progress
+        bool pending;
+        uint8_t previous;
+        uint64_t completion;
+    };
+
+    Peripheral peripheral;
+    Host::Device *devices[128];
+    Host::Statistics statistics;
+    uint64_t time;
+    bool interruptsEnabled = true;
+    bool inInterrupt = false;
+    uint8_t pins[32];
+    uint8_t modes[32];
+    // SCL pulses until the slave holding SDA releases it
+    uint8_t dataHold = 0;
+    bool clockHold = false;
+
+    uint64_t _bitsToTime(uint8_t bits)
+    {
+        uint32_t divider = 16 + 2 * (uint32_t)peripheral.bitRate * ((uint32_t)1 << (2 * peripheral.prescaler));
+        return (uint64_t)bits * divider * 1000000000ULL / F_CPU;
+    }
+
+    void _advanceBits(uint8_t bits)
+    {
+        time += _bitsToTime(bits);
+    }
+
+    void _raise(uint8_t status)
+    {
+        peripheral.status = status;
+        peripheral.interrupt = true;
+        statistics.events++;
+        statistics.statuses[status >> 3]++;
+    }
+
+    bool _isMaster()
+    {
+        return peripheral.mode == Mode::MasterStarted ||
+            peripheral.mode == Mode::MasterTransmitter ||
+            peripheral.mode == Mode::MasterReceiver;
+    }
+
+    void _stopDevice()
+    {
+        if (peripheral.device != nullptr)
+            peripheral.device->onStop();
+        peripheral.device = nullptr;
+    }
+
+    // Lines are open drain, low if any device drives them low
+    bool _lineLevel(uint8_t pin)
+    {
+        bool driven = modes[pin % sizeof(pins)] == OUTPUT && pins[pin % sizeof(pins)] == LOW;
+        if (pin == SDA)
+            return !driven && dataHold == 0;
+        return !driven && !clockHold;
+    }
+
+    // Slave holding SDA counts rising edges of SCL
+    void _countPulse(bool clock)
+    {
+        if (!clock && _lineLevel(SCL) && dataHold > 0)
+            dataHold--;
+    }
+
+    bool _isBusHeld()
+    {
+        return dataHold > 0 || clockHold;
+    }
+
+    bool _loseArbitration()
+    {
+        if (!peripheral.arbitrationLoss)
+            return false;
+        peripheral.arbitrationLoss = false;
+        _stopDevice();
+        peripheral.mode = Mode::Idle;
+        _raise(TW_MT_ARB_LOST);
+        return true;
+    }
+
+    // Execute the operation requested by clearing TWINT
+    void _step(uint8_t previous)
+    {
+        if (peripheral.control & _BV(TWSTO))
+        {
+            // Hardware clears TWSTO once STOP is sent
+            peripheral.control &= ~_BV(TWSTO);
+            if (_isMaster())
+                _stopDevice();
+            peripheral.mode = Mode::Idle;
+            if (!(peripheral.control & _BV(TWSTA)))
+                return;
+        }
+        if (peripheral.control & _BV(TWSTA))
+        {
+            // START waits for the bus to be released
+            if (_isBusHeld())
+                return;
+            if (_isMaster())
+            {
+                _stopDevice();
+                _raise(TW_REP_START);
+            }
+            else
+            {
+                _raise(TW_START);
+            }
+            peripheral.mode = Mode::MasterStarted;
+            return;
+        }
+        switch (peripheral.mode)
+        {
+        case Mode::MasterStarted:
+        {
+            bool read = peripheral.data & TW_READ;
+            statistics.bytes++;
+            if (_loseArbitration())
+                return;
+            Host::Device *device = devices[peripheral.data >> 1];
+            peripheral.mode = read ? Mode::MasterReceiver : Mode::MasterTransmitter;
+            if (device != nullptr && device->onAddress(read))
+            {
+                peripheral.device = device;
+                _raise(read ? TW_MR_SLA_ACK : TW_MT_SLA_ACK);
+            }
+            else
+            {
+                _raise(read ? TW_MR_SLA_NACK : TW_MT_SLA_NACK);
+            }
+            break;
+        }
+        case Mode::MasterTransmitter:
+            statistics.bytes++;
+            if (_loseArbitration())
+                return;
+            if (peripheral.device != nullptr && peripheral.device->onWrite(peripheral.data))
+                _raise(TW_MT_DATA_ACK);
+            else
+                _raise(TW_MT_DATA_NACK);
+            break;
+        case Mode::MasterReceiver:
+            // Nothing more can be read after NACK
+            if (peripheral.device == nullptr || previous == TW_MR_DATA_NACK)
+                break;
+            statistics.bytes++;
+            if (_loseArbitration())
+                return;
+            peripheral.data = peripheral.device->onRead();
+            _raise(peripheral.control & _BV(TWEA) ? TW_MR_DATA_ACK : TW_MR_DATA_NACK);
+            break;
+        default:
+            // Slave modes are driven by masterWrite/masterRead
+            break;
+        }
+    }
+
+    // Operations take bus time, unless forced (interrupt would fire on completion)
+    // they complete only once simulated time reaches their completion
+    void _complete(bool force)
+    {
+        if (!peripheral.pending || (!force && time < peripheral.completion))
+            return;
+        if (time < peripheral.completion)
+            time = peripheral.completion;
+        peripheral.pending = false;
+        _step(peripheral.previous);
+    }
+
+    bool _matchesAddress(uint8_t address)
+    {
+        if (address == 0)
+            return peripheral.address & _BV(TWGCE);
+        return (((address << 1) ^ peripheral.address) & ~peripheral.addressMask & 0xFE) == 0;
+    }
+
+    // Raise event for slave routine and check whether it released SCL
+    bool _raiseSlave(uint8_t status)
+    {
+        _raise(status);
+        Host::dispatch();
+        _complete(true);
+        return !peripheral.interrupt;
+    }
+}
+
+namespace
+{
+    struct Initializer
+    {
+        Initializer()
+        {
+            Host::reset();
+        }
+    } initializer;
+}
+
+Host::Register Host::twcr{RegisterId::Control};
+Host::Register Host::twdr{RegisterId::Data};
+Host::Register Host::twsr{RegisterId::Status};
+Host::Register Host::twar{RegisterId::Address};
+Host::Register Host::twamr{RegisterId::AddressMask};
+Host::Register Host::twbr{RegisterId::BitRate};
+
+Host::Register::operator uint8_t() const
+{
+    statistics.registerReads++;
+    // Every register access costs a CPU cycle
+    time += 1000000000ULL / F_CPU;
+    _complete(false);
+    switch (id)
+    {
+    case RegisterId::Control:
+        return peripheral.control | (peripheral.interrupt ? _BV(TWINT) : 0);
+    case RegisterId::Data:
+        return peripheral.data;
+    case RegisterId::Status:
+        return peripheral.status | peripheral.prescaler;
+    case RegisterId::Address:
+        return peripheral.address;
+    case RegisterId::AddressMask:
+        return peripheral.addressMask;
+    case RegisterId::BitRate:
+        return peripheral.bitRate;
+    }
+    return 0;
+}
+
+Host::Register &Host::Register::operator=(uint8_t value)
+{
+    statistics.registerWrites++;
+    time += 1000000000ULL / F_CPU;
+    switch (id)
+    {
+    case RegisterId::Control:
+        if (!(value & _BV(TWEN)))
+        {
+            // Disabling TWI aborts any operation
+            peripheral.control = value & ~(_BV(TWINT) | _BV(TWWC));
+            peripheral.interrupt = false;
+            peripheral.mode = Mode::Idle;
+            peripheral.device = nullptr;
+            peripheral.status = TW_NO_INFO;
+            peripheral.pending = false;
+            break;
+        }
+        peripheral.control = value & ~(_BV(TWINT) | _BV(TWWC));
+        // Writing TWINT starts an operation only if the flag is set
+        // (or START/STOP is requested while idle), otherwise it has no effect
+        if ((value & _BV(TWINT)) && (peripheral.interrupt ||
+            (!peripheral.pending && (value & (_BV(TWSTA) | _BV(TWSTO))))))
+        {
+            peripheral.previous = peripheral.status;
+            peripheral.interrupt = false;
+            peripheral.status = TW_NO_INFO;
+            peripheral.pending = true;
+            // START and STOP take a bit, everything else a byte and acknowledge
+            // (in slave modes the other master's timing is simulated by masterWrite/masterRead)
+            uint8_t bits = value & (_BV(TWSTA) | _BV(TWSTO))
+                ? ((value & _BV(TWSTA)) ? 1 : 0) + ((value & _BV(TWSTO)) ? 1 : 0)
+                : 9;
+            if (peripheral.mode == Mode::SlaveReceiver || peripheral.mode == Mode::SlaveTransmitter)
+                bits = 0;
+            peripheral.completion = time + _bitsToTime(bits);
+        }
+        dispatch();
+        break;
+    case RegisterId::Data:
+        peripheral.data = value;
+        break;
+    case RegisterId::Status:
+        peripheral.prescaler = value & (_BV(TWPS1) | _BV(TWPS0));
+        break;
+    case RegisterId::Address:
+        peripheral.address = value;
+        break;
+    case RegisterId::AddressMask:
+        peripheral.addressMask = value & 0xFE;
+        break;
+    case RegisterId::BitRate:
+        peripheral.bitRate = value;
+        break;
+    }
+    return *this;
+}
+
+Host::Register &Host::Register::operator=(const Register &other)
+{
+    return *this = (uint8_t)other;
+}
+
+Host::Register &Host::Register::operator|=(uint8_t value)
+{
+    return *this = (uint8_t)(*this | value);
+}
+
+Host::Register &Host::Register::operator&=(uint8_t value)
+{
+    return *this = (uint8_t)(*this & value);
+}
+
+Host::Register &Host::Register::operator^=(uint8_t value)
+{
+    return *this = (uint8_t)(*this ^ value);
+}
+
+bool Host::Device::onAddress(bool)
+{
+    return true;
+}
+
+bool Host::Device::onWrite(uint8_t)
+{
+    return true;
+}
+
+uint8_t Host::Device::onRead()
+{
+    return 0xFF;
+}
+
+void Host::Device::onStop()
+{
+}
+
+Host::RegisterDevice::RegisterDevice(uint8_t *memory, size_t size, uint8_t addressSize)
+    : memory(memory), size(size), addressSize(addressSize), pointer(0), pointerBytes(0)
+{
+}
+
+Host::RegisterDevice::RegisterDevice(uint8_t *memory, size_t size)
+    : RegisterDevice(memory, size, 1)
+{
+}
+
+bool Host::RegisterDevice::onAddress(bool read)
+{
+    // Reads continue from the current pointer
+    pointerBytes = read ? addressSize : 0;
+    return true;
+}
+
+bool Host::RegisterDevice::onWrite(uint8_t data)
+{
+    if (pointerBytes < addressSize)
+    {
+        // Register address is big endian
+        pointer = pointerBytes == 0 ? data : pointer << 8 | data;
+        pointerBytes++;
+        if (pointerBytes == addressSize)
+            pointer %= size;
+        return true;
+    }
+    memory[pointer] = data;
+    pointer = pointer + 1 < size ? pointer + 1 : 0;
+    return true;
+}
+
+uint8_t Host::RegisterDevice::onRead()
+{
+    uint8_t data = memory[pointer];
+    pointer = pointer + 1 < size ? pointer + 1 : 0;
+    return data;
+}
+
+void Host::reset()
+{
+    memset(&peripheral, 0, sizeof(peripheral));
+    peripheral.status = TW_NO_INFO;
+    peripheral.mode = Mode::Idle;
+    memset(devices, 0, sizeof(devices));
+    time = 0;
+    interruptsEnabled = true;
+    inInterrupt = false;
+    memset(pins, HIGH, sizeof(pins));
+    memset(modes, INPUT, sizeof(modes));
+    dataHold = 0;
+    clockHold = false;
+    resetStatistics();
+}
+
+void Host::attach(uint8_t address, Device *device)
+{
+    devices[address & 0x7F] = device;
+}
+
+void Host::loseArbitration()
+{
+    peripheral.arbitrationLoss = true;
+}
+
+void Host::holdData(uint8_t pulses)
+{
+    dataHold = pulses;
+}
+
+void Host::holdClock(bool held)
+{
+    clockHold = held;
+}
+
+size_t Host::masterWrite(uint8_t address, const uint8_t *data, size_t size, bool stop)
+{
+    _complete(true);
+    if (!(peripheral.control & _BV(TWEN)) || !(peripheral.control & _BV(TWEA)) ||
+        peripheral.mode != Mode::Idle || !_matchesAddress(address))
+        return 0;
+    bool generalCall = address == 0;
+    _advanceBits(10);
+    // Received SLA+W stays in TWDR
+    peripheral.data = address << 1 | TW_WRITE;
+    peripheral.mode = Mode::SlaveReceiver;
+    if (!_raiseSlave(generalCall ? TW_SR_GCALL_ACK : TW_SR_SLA_ACK))
+        return 0;
+    size_t count = 0;
+    bool ack = true;
+    while (count < size && ack)
+    {
+        // TWEA at the time TWINT was cleared decides the acknowledge
+        ack = peripheral.control & _BV(TWEA);
+        peripheral.data = data[count];
+        count++;
+        _advanceBits(9);
+        uint8_t status = generalCall
+            ? (ack ? TW_SR_GCALL_DATA_ACK : TW_SR_GCALL_DATA_NACK)
+            : (ack ? TW_SR_DATA_ACK : TW_SR_DATA_NACK);
+        if (!_raiseSlave(status))
+            return count;
+    }
+    // STOP is reported only while still addressed
+    if (stop && ack)
+    {
+        _advanceBits(1);
+        _raiseSlave(TW_SR_STOP);
+    }
+    peripheral.mode = Mode::Idle;
+    return count;
+}
+
+size_t Host::masterRead(uint8_t address, uint8_t *data, size_t size)
+{
+    _complete(true);
+    if (!(peripheral.control & _BV(TWEN)) || !(peripheral.control & _BV(TWEA)) ||
+        peripheral.mode != Mode::Idle || address == 0 || !_matchesAddress(address))
+        return 0;
+    _advanceBits(10);
+    // Received SLA+R stays in TWDR
+    peripheral.data = address << 1 | TW_READ;
+    peripheral.mode = Mode::SlaveTransmitter;
+    if (!_raiseSlave(TW_ST_SLA_ACK))
+        return 0;
+    size_t count = 0;
+    while (count < size)
+    {
+        // TWEA at the time TWINT was cleared tells whether more data follows
+        bool more = peripheral.control & _BV(TWEA);
+        data[count] = peripheral.data;
+        count++;
+        _advanceBits(9);
+        bool ack = count < size;
+        uint8_t status = !ack ? TW_ST_DATA_NACK : (more ? TW_ST_DATA_ACK : TW_ST_LAST_DATA);
+        if (!_raiseSlave(status) || status != TW_ST_DATA_ACK)
+            break;
+    }
+    // Slave released SDA, master reads ones
+    for (size_t i = count; i < size; i++)
+        data[i] = 0xFF;
+    _advanceBits(1);
+    peripheral.mode = Mode::Idle;
+    return count;
+}
+
+void Host::dispatch()
+{
+    if (inInterrupt || !interruptsEnabled || TWI_vect == nullptr)
+        return;
+    inInterrupt = true;
+    while ((peripheral.control & _BV(TWIE)) && (peripheral.control & _BV(TWEN)))
+    {
+        _complete(true);
+        if (!peripheral.interrupt)
+            break;
+        TWI_vect();
+        // Interrupt routine did not clear TWINT, it would be called forever
+        if (peripheral.interrupt)
+        {
+            if ((peripheral.control & _BV(TWIE)) && (peripheral.control & _BV(TWEN)))
+                statistics.reentries++;
+            break;
+        }
+    }
+    inInterrupt = false;
+}
+
+void Host::setInterruptsEnabled(bool enabled)
+{
+    interruptsEnabled = enabled;
+    if (enabled)
+        dispatch();
+}
+
+bool Host::getInterruptsEnabled()
+{
+    return interruptsEnabled;
+}
+
+uint64_t Host::getTime()
+{
+    return time;
+}
+
+void Host::advanceTime(uint64_t nanoseconds)
+{
+    time += nanoseconds;
+}
+
+const Host::Statistics &Host::getStatistics()
+{
+    return statistics;
+}
+
+void Host::resetStatistics()
+{
+    memset(&statistics, 0, sizeof(statistics));
+}
+
+Host::AtomicBlock::AtomicBlock()
+    : enabled(interruptsEnabled), entered(false)
+{
+    interruptsEnabled = false;
+}
+
+Host::AtomicBlock::~AtomicBlock()
+{
+    setInterruptsEnabled(enabled);
+}
+
+bool Host::AtomicBlock::enter()
+{
+    if (entered)
+        return false;
+    entered = true;
+    return true;
+}
+
+// Arduino core
+
+unsigned long micros()
+{
+    // Polling costs time too
+    time += 250;
+    return (unsigned long)(time / 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    time += (uint64_t)us * 1000;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    bool clock = _lineLevel(SCL);
+    modes[pin % sizeof(modes)] = mode;
+    _countPulse(clock);
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    bool clock = _lineLevel(SCL);
+    pins[pin % sizeof(pins)] = value;
+    _countPulse(clock);
+}
+
+int digitalRead(uint8_t pin)
+{
+    if (pin == SDA || pin == SCL)
+        return _lineLevel(pin);
+    return pins[pin % sizeof(pins)];
+}
+
+long random(long howbig)
+{
+    return howbig > 0 ? rand() % howbig : 0;
+}
+
+long random(long howsmall, long howbig)
+{
+    return howsmall < howbig ? howsmall + random(howbig - howsmall) : howsmall;
+}
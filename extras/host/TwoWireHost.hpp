@@ -0,0 +1,318 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef _BV
+#define _BV(bit) (1 << (bit))
+#endif
+
+// TWCR
+#define TWINT 7
+#define TWEA 6
+#define TWSTA 5
+#define TWSTO 4
+#define TWWC 3
+#define TWEN 2
+#define TWIE 0
+// TWSR
+#define TWPS1 1
+#define TWPS0 0
+// TWAR
+#define TWGCE 0
+
+// Same values as <compat/twi.h>
+#define TW_START 0x08
+#define TW_REP_START 0x10
+#define TW_MT_SLA_ACK 0x18
+#define TW_MT_SLA_NACK 0x20
+#define TW_MT_DATA_ACK 0x28
+#define TW_MT_DATA_NACK 0x30
+#define TW_MT_ARB_LOST 0x38
+#define TW_MR_ARB_LOST 0x38
+#define TW_MR_SLA_ACK 0x40
+#define TW_MR_SLA_NACK 0x48
+#define TW_MR_DATA_ACK 0x50
+#define TW_MR_DATA_NACK 0x58
+#define TW_ST_SLA_ACK 0xA8
+#define TW_ST_ARB_LOST_SLA_ACK 0xB0
+#define TW_ST_DATA_ACK 0xB8
+#define TW_ST_DATA_NACK 0xC0
+#define TW_ST_LAST_DATA 0xC8
+#define TW_SR_SLA_ACK 0x60
+#define TW_SR_ARB_LOST_SLA_ACK 0x68
+#define TW_SR_GCALL_ACK 0x70
+#define TW_SR_ARB_LOST_GCALL_ACK 0x78
+#define TW_SR_DATA_ACK 0x80
+#define TW_SR_DATA_NACK 0x88
+#define TW_SR_GCALL_DATA_ACK 0x90
+#define TW_SR_GCALL_DATA_NACK 0x98
+#define TW_SR_STOP 0xA0
+#define TW_NO_INFO 0xF8
+#define TW_BUS_ERROR 0x00
+#define TW_STATUS_MASK 0xF8
+#define TW_STATUS (TWSR & TW_STATUS_MASK)
+#define TW_READ 1
+#define TW_WRITE 0
+
+#define TWCR (TwoWire::Host::twcr)
+#define TWDR (TwoWire::Host::twdr)
+#define TWSR (TwoWire::Host::twsr)
+#define TWAR (TwoWire::Host::twar)
+#define TWAMR (TwoWire::Host::twamr)
+#define TWBR (TwoWire::Host::twbr)
+
+namespace TwoWire
+{
+    namespace Host
+    {
+        enum class RegisterId : uint8_t
+        {
+            Control,
+            Data,
+            Status,
+            Address,
+            AddressMask,
+            BitRate
+        };
+
+        /**
+         * @brief Simulated TWI register (reads and writes drive the simulated peripheral)
+         *
+         */
+        class Register
+        {
+        private:
+            RegisterId id;
+
+        public:
+            constexpr Register(RegisterId id) : id(id) {}
+
+            operator uint8_t() const;
+
+            Register &operator=(uint8_t value);
+            Register &operator=(const Register &other);
+            Register &operator|=(uint8_t value);
+            Register &operator&=(uint8_t value);
+            Register &operator^=(uint8_t value);
+        };
+
+        extern Register twcr;
+        extern Register twdr;
+        extern Register twsr;
+        extern Register twar;
+        extern Register twamr;
+        extern Register twbr;
+
+        /**
+         * @brief Simulated slave device on the bus (addressed by our master)
+         *
+         */
+        class Device
+        {
+        public:
+            virtual ~Device() {}
+
+            /**
+             * @brief Device was addressed
+             *
+             * @param read Whether the master is reading
+             * @return true Acknowledge the address
+             * @return false Don't acknowledge the address
+             */
+            virtual bool onAddress(bool read);
+
+            /**
+             * @brief Master sent data
+             *
+             * @param data Data
+             * @return true Acknowledge the data
+             * @return false Don't acknowledge the data
+             */
+            virtual bool onWrite(uint8_t data);
+
+            /**
+             * @brief Master reads data
+             *
+             * @return uint8_t Data
+             */
+            virtual uint8_t onRead();
+
+            /**
+             * @brief STOP (or repeated START) was received
+             *
+             */
+            virtual void onStop();
+        };
+
+        /**
+         * @brief Simulated register device (first written bytes set the register pointer,
+         *  following writes and reads auto-increment it)
+         *
+         */
+        class RegisterDevice : public Device
+        {
+        private:
+            uint8_t *memory;
+            size_t size;
+            uint8_t addressSize;
+            size_t pointer;
+            uint8_t pointerBytes;
+
+        public:
+            /**
+             * @brief Create register device
+             *
+             * @param memory Register contents
+             * @param size Size of the memory
+             * @param addressSize Size of the big endian register address in bytes
+             */
+            RegisterDevice(uint8_t *memory, size_t size, uint8_t addressSize);
+            RegisterDevice(uint8_t *memory, size_t size);
+
+            bool onAddress(bool read) override;
+            bool onWrite(uint8_t data) override;
+            uint8_t onRead() override;
+        };
+
+        struct Statistics
+        {
+            // Number of register reads
+            uint32_t registerReads;
+            // Number of register writes
+            uint32_t registerWrites;
+            // Number of TWINT events (state transitions)
+            uint32_t events;
+            // Number of bytes transferred on the bus (including addresses)
+            uint32_t bytes;
+            // Number of TWINT events per status (indexed by TW_STATUS >> 3)
+            uint32_t statuses[32];
+            // Number of times TWI_vect returned with TWINT set and the interrupt enabled
+            // (level triggered interrupt would be entered again right away)
+            uint32_t reentries;
+        };
+
+        /**
+         * @brief Reset the simulated peripheral, bus and time
+         *
+         */
+        void reset();
+
+        /**
+         * @brief Attach simulated slave device to the bus
+         *
+         * @param address 7 bit address of the device
+         * @param device Device (nullptr to detach)
+         */
+        void attach(uint8_t address, Device *device);
+
+        /**
+         * @brief Make the next master address or data byte lose arbitration
+         *
+         */
+        void loseArbitration();
+
+        /**
+         * @brief Make a slave hold SDA low as if it lost track of a transaction
+         *  (TWI can't START until SDA is released, the slave releases it after the given number of SCL pulses)
+         *
+         * @param pulses Number of SCL pulses after which SDA is released (0 to release it right away)
+         */
+        void holdData(uint8_t pulses);
+
+        /**
+         * @brief Make a slave hold SCL low
+         *
+         * @param held Whether SCL is held low
+         */
+        void holdClock(bool held);
+
+        /**
+         * @brief Write to our TWI as another master on the bus (drives slave receiver mode)
+         *  (TWI_vect has to handle the events)
+         *
+         * @param address 7 bit address (0 for general call)
+         * @param data Data to write
+         * @param size Size of the data
+         * @param stop Whether to end with STOP
+         * @return size_t Number of bytes our TWI received
+         */
+        size_t masterWrite(uint8_t address, const uint8_t *data, size_t size, bool stop);
+
+        /**
+         * @brief Read from our TWI as another master on the bus (drives slave transmitter mode)
+         *  (TWI_vect has to handle the events)
+         *
+         * @param address 7 bit address
+         * @param data Where to store the data
+         * @param size Number of bytes to read
+         * @return size_t Number of bytes our TWI transmitted
+         */
+        size_t masterRead(uint8_t address, uint8_t *data, size_t size);
+
+        /**
+         * @brief Call TWI_vect while TWINT is set and the interrupt is enabled
+         *
+         */
+        void dispatch();
+
+        /**
+         * @brief Enable or disable interrupts (cli/sei)
+         *
+         * @param enabled Whether interrupts are enabled
+         */
+        void setInterruptsEnabled(bool enabled);
+
+        /**
+         * @brief Check whether interrupts are enabled
+         *
+         * @return true Interrupts are enabled
+         * @return false Interrupts are disabled
+         */
+        bool getInterruptsEnabled();
+
+        /**
+         * @brief Get simulated time (advanced by bus activity and delays)
+         *
+         * @return uint64_t Time in nanoseconds
+         */
+        uint64_t getTime();
+
+        /**
+         * @brief Advance simulated time
+         *
+         * @param nanoseconds Time to advance
+         */
+        void advanceTime(uint64_t nanoseconds);
+
+        /**
+         * @brief Get access statistics of the simulated peripheral
+         *
+         * @return const Statistics& Statistics
+         */
+        const Statistics &getStatistics();
+
+        /**
+         * @brief Reset access statistics of the simulated peripheral
+         *
+         */
+        void resetStatistics();
+
+        /**
+         * @brief Disables interrupts for its lifetime (used by ATOMIC_BLOCK)
+         *
+         */
+        class AtomicBlock
+        {
+        private:
+            bool enabled;
+            bool entered;
+
+        public:
+            AtomicBlock();
+            ~AtomicBlock();
+
+            bool enter();
+        };
+    }
+}
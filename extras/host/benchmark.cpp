@@ -0,0 +1,907 @@
+// Runs the master and slave paths against the simulated peripheral and reports
+// register accesses, TWINT events and simulated bus time per transaction (CSV)
+
+#include <TwoWire.hpp>
+
+#include <stdio.h>
+#include <string.h>
+
+static constexpr uint8_t ownAddress = 0x10;
+static constexpr uint8_t deviceAddress = 0x50;
+static constexpr size_t size = 16;
+static constexpr int iterations = 100;
+
+static void (*handler)() = nullptr;
+
+ISR(TWI_vect)
+{
+    if (handler != nullptr)
+        handler();
+}
+
+static uint8_t memory[256];
+static TwoWire::Host::RegisterDevice device{memory, sizeof(memory)};
+
+static int failures = 0;
+static uint64_t start = 0;
+
+static void setup(uint32_t frequency)
+{
+    TwoWire::Host::reset();
+    TwoWire::Host::attach(deviceAddress, &device);
+    TwoWire::init(ownAddress, frequency);
+    handler = nullptr;
+    for (size_t i = 0; i < sizeof(memory); i++)
+        memory[i] = (uint8_t)i;
+}
+
+static void check(bool condition, const char *name)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "%s: unexpected result\n", name);
+        failures++;
+    }
+}
+
+// Overhead of the instrumentation shows up next to the rows of the plain build
+static const char *const suffix = ""
+#ifdef TWOWIRE_STATISTICS
+    "+statistics"
+#endif
+#ifdef TWOWIRE_TRACE
+    "+trace"
+#endif
+    ;
+
+static void report(const char *name, uint32_t frequency, size_t bytes)
+{
+    auto &s = TwoWire::Host::getStatistics();
+    double time = (TwoWire::Host::getTime() - start) / 1000.0 / iterations;
+    printf("%s%s,%lu,%lu,%.1f,%.1f,%.1f,%.1f,%.0f\n", name, suffix, (unsigned long)frequency, (unsigned long)bytes,
+        (double)s.registerReads / iterations, (double)s.registerWrites / iterations,
+        (double)s.events / iterations, time, bytes / (time / 1000000.0));
+}
+
+static void begin()
+{
+    TwoWire::Host::resetStatistics();
+    start = TwoWire::Host::getTime();
+}
+
+static void masterSend(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::MasterConfig m{};
+    uint8_t data[size + 1] = {0x20};
+    begin();
+    for (int i = 0; i < iterations; i++)
+        check(m.send(deviceAddress, data, sizeof(data)) == TwoWire::MStatus::Success, "master_send");
+    report("master_send", frequency, size);
+}
+
+static void masterSendTimeout(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::MasterConfig m{25000};
+    uint8_t data[size + 1] = {0x20};
+    begin();
+    for (int i = 0; i < iterations; i++)
+        check(m.send(deviceAddress, data, sizeof(data)) == TwoWire::MStatus::Success, "master_send_timeout");
+    report("master_send_timeout", frequency, size);
+    // Timeout checks don't change the result of a failed operation
+    check(m.send(deviceAddress + 3, data, sizeof(data)) == TwoWire::MStatus::AddressNACK, "master_send_timeout");
+}
+
+// Policies resolved at compile time (compare with master_send and master_send_timeout)
+static void basicMasterSend(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::BasicMaster<> m{};
+    uint8_t data[size + 1] = {0x20};
+    begin();
+    for (int i = 0; i < iterations; i++)
+        check(m.send(deviceAddress, data, sizeof(data)) == TwoWire::MStatus::Success, "basic_master_send");
+    report("basic_master_send", frequency, size);
+    // Without an error policy the bus is still released after a failure
+    check(m.send(deviceAddress + 3, data, sizeof(data)) == TwoWire::MStatus::AddressNACK, "basic_master_send");
+    check(m.send(deviceAddress, data, sizeof(data)) == TwoWire::MStatus::Success, "basic_master_send");
+}
+
+static void basicMasterSendTimeout(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::BasicMaster<TwoWire::MasterPolicy::FixedTimeout<25000>> m{};
+    uint8_t data[size + 1] = {0x20};
+    begin();
+    for (int i = 0; i < iterations; i++)
+        check(m.send(deviceAddress, data, sizeof(data)) == TwoWire::MStatus::Success, "basic_master_send_timeout");
+    report("basic_master_send_timeout", frequency, size);
+    // Caller's deadline works with any timeout policy
+    TwoWire::Deadline d{100};
+    check(m.send(deviceAddress, data, sizeof(data), true, d) == TwoWire::MStatus::Timeout, "basic_master_send_timeout");
+}
+
+static void masterDeadline(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::MasterConfiguration c{};
+    TwoWire::MasterConfig m{};
+    uint8_t data[size + 1] = {0x20};
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        // Manual transaction bounded by a single deadline
+        TwoWire::Deadline d{5000};
+        check(c.signalStart(d) == TwoWire::MStatus::Success, "master_deadline");
+        check(c.addressForWriting(deviceAddress, d) == TwoWire::MStatus::Success, "master_deadline");
+        uint32_t remaining = d.getRemaining();
+        check(c.sendData(data, sizeof(data), d) == TwoWire::MStatus::Success, "master_deadline");
+        check(d.getRemaining() < remaining, "master_deadline");
+        TwoWire::signalStop();
+    }
+    report("master_deadline", frequency, size);
+    // Deadline shorter than the transfer stops it (retries don't extend it)
+    TwoWire::Deadline d{100};
+    check(m.send(deviceAddress, data, sizeof(data), true, d) == TwoWire::MStatus::Timeout && d.isExpired(), "master_deadline");
+    check(m.getAttempts() == 1, "master_deadline");
+}
+
+static void busRecovery(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::BusRecovery recovery{frequency, false};
+    TwoWire::MasterConfig m{5000};
+    m.setRetryPolicy({2, m.retryOn(TwoWire::MStatus::Timeout), TwoWire::MBackoff::None, 0});
+    m.setBusRecovery(&recovery);
+    uint8_t data[size + 1] = {0x20};
+    uint32_t duration = 0;
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        // Slave reset in the middle of a read holds SDA until it shifts out its byte
+        TwoWire::Host::holdData(5);
+        check(m.send(deviceAddress, data, sizeof(data)) == TwoWire::MStatus::Success && m.getAttempts() == 2, "bus_recovery");
+        auto r = recovery.getLastReport();
+        check(r.result == TwoWire::RResult::Recovered && r.pulses == 5 && r.dataWasHeld, "bus_recovery");
+        duration += r.duration;
+    }
+    report("bus_recovery", frequency, size);
+    check(recovery.getRecoveryCount() == iterations && duration / iterations < 150, "bus_recovery");
+    // Settings survive the recovery
+    check(TwoWire::getAddress() == ownAddress && TwoWire::getFrequency() == frequency, "bus_recovery");
+    // Held clock can't be recovered
+    TwoWire::Host::holdClock(true);
+    check(recovery.recover().result == TwoWire::RResult::ClockHeld, "bus_recovery");
+    TwoWire::Host::holdClock(false);
+    // Slow pulses keep their half period (500 us at 1 kHz)
+    TwoWire::BusRecovery slow{1000, false};
+    TwoWire::Host::holdData(5);
+    auto r = slow.recover();
+    check(r.result == TwoWire::RResult::Recovered && r.pulses == 5 && r.duration >= 5 * 2 * 500, "bus_recovery");
+    // Idle bus is left alone
+    check(m.send(deviceAddress, data, sizeof(data)) == TwoWire::MStatus::Success && recovery.getRecoveryCount() == iterations + 1, "bus_recovery");
+    // Timeout isn't retried without an attempt limit (the restarted timeout would never end the operation)
+    m.setRetryPolicy({0, m.retryOn(TwoWire::MStatus::Timeout), TwoWire::MBackoff::None, 0});
+    TwoWire::Host::holdClock(true);
+    check(m.send(deviceAddress, data, sizeof(data)) == TwoWire::MStatus::Timeout && m.getAttempts() == 1, "bus_recovery");
+    TwoWire::Host::holdClock(false);
+    check(m.send(deviceAddress, data, sizeof(data)) == TwoWire::MStatus::Success, "bus_recovery");
+}
+
+static void masterReceiveRegister(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::MasterConfig m{};
+    uint8_t data[size];
+    begin();
+    for (int i = 0; i < iterations; i++)
+        check(m.receiveRegister(deviceAddress, 0x20, data, sizeof(data), true) == TwoWire::MStatus::Success, "master_receive_register");
+    report("master_receive_register", frequency, size);
+    check(memcmp(data, memory + 0x20, sizeof(data)) == 0, "master_receive_register");
+}
+
+static void masterSendSegments(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::MasterConfig m{};
+    uint8_t header = 0x20;
+    uint8_t payload[size];
+    for (size_t i = 0; i < size; i++)
+        payload[i] = (uint8_t)~i;
+    const TwoWire::MSendSegment segments[] = {{&header, 1}, {payload, size / 2}, {payload + size / 2, size / 2}};
+    begin();
+    for (int i = 0; i < iterations; i++)
+        check(m.send(deviceAddress, segments, 3) == TwoWire::MStatus::Success, "master_send_segments");
+    report("master_send_segments", frequency, size);
+    check(memcmp(memory + 0x20, payload, size) == 0, "master_send_segments");
+}
+
+static void masterReceiveSegments(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::MasterConfig m{};
+    uint8_t header[4];
+    uint8_t payload[size - sizeof(header)];
+    const TwoWire::MReceiveSegment segments[] = {{header, sizeof(header)}, {nullptr, 0}, {payload, sizeof(payload)}};
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        check(m.send(deviceAddress, 0x20, false) == TwoWire::MStatus::Success, "master_receive_segments");
+        check(m.receive(deviceAddress, segments, 3) == TwoWire::MStatus::Success, "master_receive_segments");
+    }
+    report("master_receive_segments", frequency, size);
+    check(memcmp(header, memory + 0x20, sizeof(header)) == 0, "master_receive_segments");
+    check(memcmp(payload, memory + 0x20 + sizeof(header), sizeof(payload)) == 0, "master_receive_segments");
+}
+
+static uint8_t wideMemory[1024];
+static TwoWire::Host::RegisterDevice wideDevice{wideMemory, sizeof(wideMemory), 2};
+
+static void masterWriteRegister(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::Host::attach(deviceAddress + 1, &wideDevice);
+    TwoWire::MasterConfig m{};
+    uint8_t data[size];
+    for (size_t i = 0; i < size; i++)
+        data[i] = (uint8_t)(i * 3);
+    begin();
+    for (int i = 0; i < iterations; i++)
+        check(m.writeRegister<2, TwoWire::MByteOrder::BigEndian>(deviceAddress + 1, 0x0234, data, size) == TwoWire::MStatus::Success, "master_write_register");
+    report("master_write_register", frequency, size);
+    check(memcmp(wideMemory + 0x0234, data, size) == 0, "master_write_register");
+    // 8 bit register address
+    check(m.writeRegister(deviceAddress, 0x40, data, size) == TwoWire::MStatus::Success, "master_write_register");
+    check(memcmp(memory + 0x40, data, size) == 0, "master_write_register");
+}
+
+static void masterReceiveRegisterWide(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::Host::attach(deviceAddress + 1, &wideDevice);
+    for (size_t i = 0; i < sizeof(wideMemory); i++)
+        wideMemory[i] = (uint8_t)(i >> 2);
+    TwoWire::MasterConfig m{};
+    uint8_t data[size];
+    begin();
+    for (int i = 0; i < iterations; i++)
+        check(m.receiveRegister<2, TwoWire::MByteOrder::BigEndian>(deviceAddress + 1, 0x0310, data, size, true) == TwoWire::MStatus::Success, "master_receive_register_wide");
+    report("master_receive_register_wide", frequency, size);
+    check(memcmp(data, wideMemory + 0x0310, size) == 0, "master_receive_register_wide");
+    // Little endian address reaches the same register
+    check(m.receiveRegister<2, TwoWire::MByteOrder::LittleEndian>(deviceAddress + 1, 0x1003, data, size, false) == TwoWire::MStatus::Success, "master_receive_register_wide");
+    check(memcmp(data, wideMemory + 0x0310, size) == 0, "master_receive_register_wide");
+}
+
+// 24C32-like EEPROM: 2 byte address, 32 byte pages, 5 ms write cycle without acknowledging its address
+class Eeprom : public TwoWire::Host::Device
+{
+public:
+    uint8_t memory[4096];
+    size_t pointer = 0;
+    uint8_t addressBytes = 0;
+    size_t written = 0;
+    uint64_t readyTime = 0;
+    bool pageCrossed = false;
+
+    bool onAddress(bool read) override
+    {
+        if (TwoWire::Host::getTime() < readyTime)
+            return false;
+        addressBytes = read ? 2 : 0;
+        written = 0;
+        return true;
+    }
+
+    bool onWrite(uint8_t data) override
+    {
+        if (addressBytes < 2)
+        {
+            pointer = (addressBytes == 0 ? data : pointer << 8 | data) % sizeof(memory);
+            addressBytes++;
+            return true;
+        }
+        // Page write wraps around within the page
+        size_t page = pointer & ~(size_t)31;
+        if (written > 0 && pointer == page)
+            pageCrossed = true;
+        memory[pointer] = data;
+        pointer = page | ((pointer + 1) & 31);
+        written++;
+        return true;
+    }
+
+    uint8_t onRead() override
+    {
+        uint8_t data = memory[pointer];
+        pointer = (pointer + 1) % sizeof(memory);
+        return data;
+    }
+
+    void onStop() override
+    {
+        if (written > 0)
+            readyTime = TwoWire::Host::getTime() + 5000000;
+        written = 0;
+    }
+};
+
+static Eeprom eeprom;
+
+static void memoryDeviceWrite(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::Host::attach(deviceAddress + 2, &eeprom);
+    eeprom.readyTime = 0;
+    TwoWire::MasterConfig m{};
+    TwoWire::MemoryDevice d{m, deviceAddress + 2, 2, 32};
+    uint8_t data[100];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (uint8_t)(i + 7);
+    uint8_t readBack[sizeof(data)];
+#ifdef TWOWIRE_STATISTICS
+    TwoWire::Statistics::reset();
+#endif
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        // Unaligned write over 4 pages
+        check(d.write(0x0110 + i, data, sizeof(data)) == TwoWire::MStatus::Success, "memory_device_write");
+        check(d.read(0x0110 + i, readBack, sizeof(readBack)) == TwoWire::MStatus::Success, "memory_device_write");
+        check(memcmp(readBack, data, sizeof(data)) == 0, "memory_device_write");
+    }
+    report("memory_device_write", frequency, sizeof(data));
+    check(!eeprom.pageCrossed, "memory_device_write");
+#ifdef TWOWIRE_STATISTICS
+    // Acknowledge polling NACKs are expected, they aren't transactions of the master
+    TwoWire::Statistics::AddressStatistics a;
+    check(TwoWire::Statistics::getAddressStatistics(deviceAddress + 2, a) &&
+        a.statuses[(uint8_t)TwoWire::MStatus::AddressNACK] == 0 && a.statuses[(uint8_t)TwoWire::MStatus::Success] == a.transactions,
+        "memory_device_write");
+#endif
+}
+
+static uint8_t cacheStorage[TwoWire::MemoryCache::getStorageSize(32, 4)];
+static TwoWire::MemoryCache::Line cacheLines[4];
+
+static void memoryCache(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::Host::attach(deviceAddress + 2, &eeprom);
+    eeprom.readyTime = 0;
+    for (size_t i = 0; i < sizeof(eeprom.memory); i++)
+        eeprom.memory[i] = (uint8_t)(i * 5);
+    TwoWire::MasterConfig m{};
+    TwoWire::MemoryDevice d{m, deviceAddress + 2, 2, 32};
+    TwoWire::MemoryCache c{d, cacheStorage, cacheLines, 4, 32};
+    uint8_t data[8];
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        // Small overlapping reads of a hot table
+        check(c.read(0x0204 + i % 16, data, sizeof(data)) == TwoWire::MStatus::Success, "memory_cache");
+        check(data[0] == (uint8_t)((0x0204 + i % 16) * 5), "memory_cache");
+        // Bursty small writes to one page
+        data[0] = (uint8_t)i;
+        check(c.write(0x0300 + i % 32, data, 1) == TwoWire::MStatus::Success, "memory_cache");
+    }
+    check(c.isDirty(), "memory_cache");
+    check(c.flush() == TwoWire::MStatus::Success && !c.isDirty(), "memory_cache");
+    report("memory_cache", frequency, sizeof(data));
+    for (int i = iterations - 32; i < iterations; i++)
+        check(eeprom.memory[0x0300 + i % 32] == (uint8_t)i, "memory_cache");
+    // Invalidated lines are read from the memory again
+    eeprom.memory[0x0204] = 0xAA;
+    c.invalidate();
+    check(d.awaitReady() == TwoWire::MStatus::Success, "memory_cache");
+    check(c.read(0x0204, data, 1) == TwoWire::MStatus::Success && data[0] == 0xAA, "memory_cache");
+    // Aligned line-sized reads are cached as well, only the first one reaches the bus
+    uint8_t line[32];
+    check(c.read(0x0260, line, sizeof(line)) == TwoWire::MStatus::Success, "memory_cache_line");
+    TwoWire::Host::resetStatistics();
+    for (int i = 0; i < 4; i++)
+        check(c.read(0x0260, line, sizeof(line)) == TwoWire::MStatus::Success && line[1] == (uint8_t)(0x0261 * 5), "memory_cache_line");
+    check(TwoWire::Host::getStatistics().events == 0, "memory_cache_line");
+}
+
+static uint8_t cachedRegisters[64];
+static uint8_t cachedValid[TwoWire::RegisterCache::getMaskSize(sizeof(cachedRegisters))];
+static uint8_t cachedDirty[TwoWire::RegisterCache::getMaskSize(sizeof(cachedRegisters))];
+static const uint8_t cachedVolatile[TwoWire::RegisterCache::getMaskSize(sizeof(cachedRegisters))] = {0x01};
+
+static void registerCache(uint32_t frequency)
+{
+    setup(frequency);
+    TwoWire::MasterConfig m{};
+    TwoWire::RegisterCache c{m, deviceAddress, cachedRegisters, sizeof(cachedRegisters), cachedValid, cachedDirty, cachedVolatile};
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        // Configure 8 adjacent registers bit by bit
+        for (uint8_t r = 0x10; r < 0x18; r++)
+        {
+            check(c.updateBits(r, 0x0F, (uint8_t)i) == TwoWire::MStatus::Success, "register_cache");
+            check(c.updateBits(r, 0xF0, (uint8_t)(r << 4)) == TwoWire::MStatus::Success, "register_cache");
+        }
+        check(c.isDirty(), "register_cache");
+        check(c.sync() == TwoWire::MStatus::Success && !c.isDirty(), "register_cache");
+    }
+    report("register_cache", frequency, 8);
+    for (uint8_t r = 0x10; r < 0x18; r++)
+        check(memory[r] == (uint8_t)((r << 4) | ((iterations - 1) & 0x0F)), "register_cache");
+    // Volatile register is read from the device every time
+    uint8_t value;
+    memory[0] = 0x5A;
+    check(c.read(0, &value) == TwoWire::MStatus::Success && value == 0x5A, "register_cache");
+    memory[0] = 0xA5;
+    check(c.read(0, &value) == TwoWire::MStatus::Success && value == 0xA5, "register_cache");
+}
+
+static TwoWire::MasterAsync::Transaction queue[12];
+static TwoWire::MasterAsync async{queue, sizeof(queue) / sizeof(queue[0])};
+
+static void masterAsyncReceiveRegister(uint32_t frequency)
+{
+    setup(frequency);
+    handler = [] { async.interruptVectorRoutine(); };
+    uint8_t data[size];
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        check(async.receiveRegister(deviceAddress, 0x20, data, sizeof(data), true), "master_async_receive_register");
+        check(!async.isBusy() && async.getStatus() == TwoWire::MStatus::Success, "master_async_receive_register");
+    }
+    report("master_async_receive_register", frequency, size);
+    check(memcmp(data, memory + 0x20, sizeof(data)) == 0, "master_async_receive_register");
+    // Bus kept after completion leaves TWINT set, the interrupt must not be entered again
+    begin();
+    check(async.receive(deviceAddress, data, sizeof(data), false), "master_async_hold");
+    check(!async.isBusy() && async.getStatus() == TwoWire::MStatus::Success, "master_async_hold");
+    check(TwoWire::Host::getStatistics().reentries == 0, "master_async_hold");
+    // Next transaction starts with repeated START and releases the bus
+    check(async.send(deviceAddress, data, sizeof(data)), "master_async_hold");
+    check(!async.isBusy() && async.getStatus() == TwoWire::MStatus::Success, "master_async_hold");
+    check(TwoWire::Host::getStatistics().reentries == 0, "master_async_hold");
+}
+
+static uint8_t slaveBuffer[size];
+static TwoWire::SlaveReceiver receiver{slaveBuffer, sizeof(slaveBuffer)};
+static TwoWire::SlaveTransmitter transmitter{memory, size};
+
+static TwoWire::MasterAsync::Transaction sharedQueue[4];
+static TwoWire::MasterAsync sharedAsync{sharedQueue, sizeof(sharedQueue) / sizeof(sharedQueue[0])};
+static uint8_t sharedBuffer[size];
+static TwoWire::SlaveReceiver sharedReceiver{sharedBuffer, sizeof(sharedBuffer)};
+static TwoWire::ArbitrationManager arbitration{sharedAsync, TwoWire::SlaveDispatcher::handler(sharedReceiver), 2};
+
+static void masterAsyncArbitration(uint32_t frequency)
+{
+    setup(frequency);
+    handler = [] { arbitration.interruptVectorRoutine(); };
+    TwoWire::enableInterrupt();
+    arbitration.resetStatistics();
+    uint8_t data[size];
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        // Another master wins the address byte, transaction is restarted
+        TwoWire::Host::loseArbitration();
+        check(sharedAsync.receiveRegister(deviceAddress, 0x20, data, sizeof(data), true), "master_async_arbitration");
+        check(!sharedAsync.isBusy() && sharedAsync.getStatus() == TwoWire::MStatus::Success, "master_async_arbitration");
+        // and then writes to us
+        sharedReceiver.receiveNextData();
+        TwoWire::Host::masterWrite(ownAddress, memory, size, true);
+        check(sharedReceiver.isDataAvailable() && sharedReceiver.getDataSize() == size, "master_async_arbitration");
+    }
+    report("master_async_arbitration", frequency, 2 * size);
+    auto s = arbitration.getStatistics();
+    check(s.arbitrationLost == iterations && s.slaveTransactions == iterations, "master_async_arbitration");
+    check(memcmp(data, memory + 0x20, sizeof(data)) == 0, "master_async_arbitration");
+    // Another master holds the bus while our START waits, then addresses us without any arbitration lost
+    // (the slave routine clears TWSTA, START is requested again once the slave transaction ends)
+    TwoWire::Host::holdClock(true);
+    check(sharedAsync.receiveRegister(deviceAddress, 0x20, data, sizeof(data), true), "master_async_arbitration");
+    check(sharedAsync.isBusy(), "master_async_arbitration");
+    TwoWire::Host::holdClock(false);
+    sharedReceiver.receiveNextData();
+    check(TwoWire::Host::masterWrite(ownAddress, memory, size, true) == size, "master_async_arbitration");
+    check(!sharedAsync.isBusy() && sharedAsync.getStatus() == TwoWire::MStatus::Success, "master_async_arbitration");
+    check(arbitration.getStatistics().arbitrationLost == iterations, "master_async_arbitration");
+    // Transaction submitted while the slave role is served waits for it instead of overwriting its TWINT
+    static uint8_t *received;
+    received = data;
+    memset(data, 0, sizeof(data));
+    handler = []
+    {
+        if (TW_STATUS == TW_SR_SLA_ACK)
+        {
+            check(sharedAsync.receiveRegister(deviceAddress, 0x20, received, size, true), "master_async_submit_slave");
+            check(TW_STATUS == TW_SR_SLA_ACK && (TWCR & _BV(TWINT)), "master_async_submit_slave");
+        }
+        arbitration.interruptVectorRoutine();
+    };
+    sharedReceiver.receiveNextData();
+    check(TwoWire::Host::masterWrite(ownAddress, memory, size, true) == size, "master_async_submit_slave");
+    check(sharedReceiver.isDataAvailable() && sharedReceiver.getDataSize() == size, "master_async_submit_slave");
+    check(!sharedAsync.isBusy() && sharedAsync.getStatus() == TwoWire::MStatus::Success, "master_async_submit_slave");
+    check(memcmp(data, memory + 0x20, sizeof(data)) == 0, "master_async_submit_slave");
+}
+
+static void slaveReceive(uint32_t frequency)
+{
+    setup(frequency);
+    handler = [] { receiver.interruptVectorRoutine(); };
+    TwoWire::enableInterrupt();
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        receiver.receiveNextData();
+        TwoWire::Host::masterWrite(ownAddress, memory, size, true);
+        check(receiver.isDataAvailable() && receiver.getDataSize() == size, "slave_receive");
+    }
+    report("slave_receive", frequency, size);
+    check(memcmp(slaveBuffer, memory, size) == 0, "slave_receive");
+    // Single storage location isn't completed by a shorter write
+    receiver.receiveNextData();
+    TwoWire::Host::masterWrite(ownAddress, memory, size / 2, true);
+    check(!receiver.isDataAvailable(), "slave_receive_short");
+    TwoWire::Host::masterWrite(ownAddress, memory, size, true);
+    check(receiver.isDataAvailable() && receiver.getDataSize() == size, "slave_receive_short");
+}
+
+static uint8_t pingBuffer[size];
+static uint8_t pongBuffer[size];
+static TwoWire::SlaveReceiver::Buffer buffers[] = {{pingBuffer, size, 0}, {pongBuffer, size, 0}};
+static TwoWire::SlaveReceiver pingPongReceiver{buffers, 2};
+
+static void slaveReceivePingPong(uint32_t frequency)
+{
+    setup(frequency);
+    handler = [] { pingPongReceiver.interruptVectorRoutine(); };
+    TwoWire::enableInterrupt();
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        // Second burst arrives before the first one is processed
+        TwoWire::Host::masterWrite(ownAddress, memory, size, true);
+        check(TwoWire::Host::masterWrite(ownAddress, memory + size, size / 2, true) == size / 2, "slave_receive_ping_pong");
+        check(pingPongReceiver.isDataAvailable() && pingPongReceiver.getDataSize() == size, "slave_receive_ping_pong");
+        check(memcmp(pingPongReceiver.getData(), memory, size) == 0, "slave_receive_ping_pong");
+        pingPongReceiver.receiveNextData();
+        check(pingPongReceiver.isDataAvailable() && pingPongReceiver.getDataSize() == size / 2, "slave_receive_ping_pong");
+        check(memcmp(pingPongReceiver.getData(), memory + size, size / 2) == 0, "slave_receive_ping_pong");
+        pingPongReceiver.receiveNextData();
+    }
+    report("slave_receive_ping_pong", frequency, size + size / 2);
+}
+
+static uint8_t frameData[2 * size];
+static TwoWire::SlaveFrameReceiver::Frame frames[4];
+static TwoWire::SlaveFrameReceiver frameReceiver{frameData, sizeof(frameData), frames, 4};
+
+static void slaveReceiveFrames(uint32_t frequency)
+{
+    setup(frequency);
+    handler = [] { frameReceiver.interruptVectorRoutine(); };
+    TwoWire::enableInterrupt();
+    uint8_t data[size];
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        // Variable-length messages arrive before the main loop pops them
+        for (size_t length = 3; length <= 9; length += 3)
+            TwoWire::Host::masterWrite(ownAddress, memory + length, length, true);
+        for (size_t length = 3; length <= 9; length += 3)
+        {
+            check(frameReceiver.isFrameAvailable(), "slave_receive_frames");
+            check(frameReceiver.readFrame(data, sizeof(data)) == length, "slave_receive_frames");
+            check(memcmp(data, memory + length, length) == 0, "slave_receive_frames");
+            frameReceiver.nextFrame();
+        }
+        check(!frameReceiver.isFrameAvailable(), "slave_receive_frames");
+    }
+    report("slave_receive_frames", frequency, 18);
+    // Message longer than the ring is NACKed once it's full and marked truncated
+    check(TwoWire::Host::masterWrite(ownAddress, memory, sizeof(frameData) + 4, true) == sizeof(frameData), "slave_receive_frames_truncated");
+    check(frameReceiver.isFrameAvailable() && frameReceiver.isTruncated(), "slave_receive_frames_truncated");
+    check(frameReceiver.getFrameSize() == sizeof(frameData) - 1, "slave_receive_frames_truncated");
+    frameReceiver.nextFrame();
+    TwoWire::Host::masterWrite(ownAddress, memory, 3, true);
+    check(frameReceiver.isFrameAvailable() && !frameReceiver.isTruncated(), "slave_receive_frames_truncated");
+    check(frameReceiver.getFrameSize() == 3, "slave_receive_frames_truncated");
+    frameReceiver.nextFrame();
+}
+
+static void slaveTransmit(uint32_t frequency)
+{
+    setup(frequency);
+    handler = [] { transmitter.interruptVectorRoutine(); };
+    TwoWire::enableInterrupt();
+    uint8_t data[size];
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        transmitter.transmitDataAgain();
+        check(TwoWire::Host::masterRead(ownAddress, data, size) == size, "slave_transmit");
+    }
+    report("slave_transmit", frequency, size);
+    check(memcmp(data, memory, size) == 0, "slave_transmit");
+}
+
+static TwoWire::SlaveTransmitter generatorTransmitter{[](size_t index, void *context) { return ((uint8_t *)context)[index]; }, memory};
+
+static void slaveTransmitGenerator(uint32_t frequency)
+{
+    setup(frequency);
+    handler = [] { generatorTransmitter.interruptVectorRoutine(); };
+    TwoWire::enableInterrupt();
+    uint8_t data[size];
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        check(TwoWire::Host::masterRead(ownAddress, data, size) == size, "slave_transmit_generator");
+        check(generatorTransmitter.isDataTransmitted(), "slave_transmit_generator");
+    }
+    report("slave_transmit_generator", frequency, size);
+    check(memcmp(data, memory, size) == 0, "slave_transmit_generator");
+}
+
+static size_t generateChunk(uint8_t *data, size_t chunkSize, size_t index, void *context)
+{
+    memcpy(data, (uint8_t *)context + index, chunkSize);
+    return chunkSize;
+}
+
+static uint8_t chunk[4];
+static TwoWire::SlaveTransmitter chunkTransmitter{generateChunk, chunk, sizeof(chunk), memory};
+
+static void slaveTransmitChunks(uint32_t frequency)
+{
+    setup(frequency);
+    handler = [] { chunkTransmitter.interruptVectorRoutine(); };
+    TwoWire::enableInterrupt();
+    uint8_t data[size];
+    begin();
+    for (int i = 0; i < iterations; i++)
+        check(TwoWire::Host::masterRead(ownAddress, data, size) == size, "slave_transmit_chunks");
+    report("slave_transmit_chunks", frequency, size);
+    check(memcmp(data, memory, size) == 0, "slave_transmit_chunks");
+}
+
+static uint8_t snapshots[TwoWire::SlaveTransmitter::getSnapshotStorageSize(size)];
+static TwoWire::SlaveTransmitter snapshotTransmitter{};
+static int snapshotEvents = 0;
+
+static void slaveTransmitSnapshots(uint32_t frequency)
+{
+    setup(frequency);
+    snapshotTransmitter.transmitSnapshots(snapshots, size);
+    snapshotTransmitter.publishSnapshot(memory);
+    handler = []
+    {
+        snapshotTransmitter.interruptVectorRoutine();
+        // Main loop publishes a new version in the middle of every read
+        if (++snapshotEvents % 8 == 4)
+        {
+            uint8_t *snapshot = snapshotTransmitter.beginSnapshot();
+            memcpy(snapshot, memory + size * (snapshotEvents % 2 ? 1 : 2), size);
+            snapshotTransmitter.publishSnapshot();
+        }
+    };
+    TwoWire::enableInterrupt();
+    uint8_t data[size];
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        check(TwoWire::Host::masterRead(ownAddress, data, size) == size, "slave_transmit_snapshots");
+        // Every read streams a single version
+        check(memcmp(data, memory, size) == 0 || memcmp(data, memory + size, size) == 0 ||
+                  memcmp(data, memory + 2 * size, size) == 0,
+              "slave_transmit_snapshots");
+    }
+    report("slave_transmit_snapshots", frequency, size);
+}
+
+static uint8_t registers[64];
+static TwoWire::SlaveRegisterMap registerMap{registers, sizeof(registers)};
+
+static void slaveRegisterMap(uint32_t frequency)
+{
+    setup(frequency);
+    handler = [] { registerMap.interruptVectorRoutine(); };
+    TwoWire::enableInterrupt();
+    uint8_t request[size + 1] = {0x20};
+    memcpy(request + 1, memory, size);
+    uint8_t data[size];
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        check(TwoWire::Host::masterWrite(ownAddress, request, sizeof(request), true) == sizeof(request), "slave_register_map");
+        check(TwoWire::Host::masterWrite(ownAddress, request, 1, false) == 1, "slave_register_map");
+        check(TwoWire::Host::masterRead(ownAddress, data, size) == size, "slave_register_map");
+    }
+    report("slave_register_map", frequency, 2 * size);
+    check(memcmp(data, memory, size) == 0, "slave_register_map");
+    // Pointer out of the map starts at register 0
+    uint8_t outside[2] = {sizeof(registers) + 5, 0x5A};
+    check(TwoWire::Host::masterWrite(ownAddress, outside, sizeof(outside), true) == sizeof(outside), "slave_register_map");
+    check(registers[0] == 0x5A && registerMap.getPointer() == 1, "slave_register_map");
+}
+
+static uint8_t emulatedRegisters[16];
+static TwoWire::SlaveRegisterMap emulatedRegisterMap{emulatedRegisters, sizeof(emulatedRegisters)};
+static uint8_t emulatedBuffer[size];
+static TwoWire::SlaveReceiver emulatedReceiver{emulatedBuffer, sizeof(emulatedBuffer)};
+static TwoWire::SlaveTransmitter emulatedTransmitter{memory, size};
+static const TwoWire::SlaveDispatcher::Handler emulatedDevices[] = {
+    TwoWire::SlaveDispatcher::handler(emulatedRegisterMap),
+    TwoWire::SlaveDispatcher::handler(emulatedReceiver),
+    TwoWire::SlaveDispatcher::handler(emulatedTransmitter),
+    TwoWire::SlaveDispatcher::none(),
+};
+static TwoWire::SlaveDispatcher dispatcher{0x20, emulatedDevices, 4};
+
+static void slaveDispatcher(uint32_t frequency)
+{
+    setup(frequency);
+    dispatcher.setAddresses();
+    handler = [] { dispatcher.interruptVectorRoutine(); };
+    TwoWire::enableInterrupt();
+    uint8_t request[5] = {0x04, 1, 2, 3, 4};
+    uint8_t data[size];
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        check(TwoWire::Host::masterWrite(0x20, request, sizeof(request), true) == sizeof(request), "slave_dispatcher");
+        emulatedReceiver.receiveNextData();
+        check(TwoWire::Host::masterWrite(0x21, memory, size, true) == size, "slave_dispatcher");
+        check(emulatedReceiver.isDataAvailable(), "slave_dispatcher");
+        emulatedTransmitter.transmitDataAgain();
+        check(TwoWire::Host::masterRead(0x22, data, size) == size, "slave_dispatcher");
+        // Address without a handler refuses data
+        check(TwoWire::Host::masterWrite(0x23, request, sizeof(request), true) == 1, "slave_dispatcher");
+        check(TwoWire::Host::masterWrite(0x24, request, sizeof(request), true) == 0, "slave_dispatcher");
+    }
+    report("slave_dispatcher", frequency, 2 * size + sizeof(request));
+    check(memcmp(emulatedRegisters + 4, request + 1, 4) == 0, "slave_dispatcher");
+    check(memcmp(emulatedBuffer, memory, size) == 0, "slave_dispatcher");
+    check(memcmp(data, memory, size) == 0, "slave_dispatcher");
+}
+
+#ifdef TWOWIRE_STATISTICS
+static void statistics(uint32_t frequency)
+{
+    setup(frequency);
+    handler = [] { receiver.interruptVectorRoutine(); };
+    TwoWire::Statistics::reset();
+    TwoWire::MasterConfig m{};
+    uint8_t data[size + 1] = {0x20};
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        check(m.send(deviceAddress, data, sizeof(data)) == TwoWire::MStatus::Success, "statistics_counters");
+        check(m.receiveRegister(deviceAddress, 0x20, data, size, true) == TwoWire::MStatus::Success, "statistics_counters");
+        // Slave routine runs in the interrupt
+        TwoWire::enableInterrupt();
+        receiver.receiveNextData();
+        TwoWire::Host::masterWrite(ownAddress, memory, size, true);
+        TwoWire::disableInterrupt();
+    }
+    report("statistics_counters", frequency, 2 * size);
+    check(m.probe(deviceAddress + 3) == TwoWire::MStatus::AddressNACK, "statistics_counters");
+    TwoWire::Statistics::AddressStatistics a;
+    check(TwoWire::Statistics::getAddressStatistics(deviceAddress, a), "statistics_counters");
+    check(a.transactions == 2 * iterations && a.bytes == (uint32_t)iterations * (sizeof(data) + 1 + size) &&
+        a.statuses[(uint8_t)TwoWire::MStatus::Success] == 2 * iterations && a.retries == 0, "statistics_counters");
+    check(TwoWire::Statistics::getAddressStatistics(deviceAddress + 3, a) &&
+        a.statuses[(uint8_t)TwoWire::MStatus::AddressNACK] == 1, "statistics_counters");
+    check(!TwoWire::Statistics::getAddressStatistics(deviceAddress + 4, a), "statistics_counters");
+    auto slave = TwoWire::Statistics::getSlaveStatistics();
+    check(slave.receptions == iterations && slave.bytesReceived == (uint32_t)iterations * size && slave.transmissions == 0, "statistics_counters");
+    // Every transaction lands in exactly one bucket
+    TwoWire::Statistics::Histogram h;
+    TwoWire::Statistics::getHistogram(TwoWire::Statistics::Transaction::Send, h);
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < TwoWire::Statistics::HISTOGRAM_BUCKETS; i++)
+        total += h.buckets[i];
+    check(total == iterations, "statistics_counters");
+    check(TwoWire::Statistics::getBucket(0) == 0 && TwoWire::Statistics::getBucket(1) == 1 &&
+        TwoWire::Statistics::getBucket(1500) == 11 && TwoWire::Statistics::getBucket(UINT32_MAX) == 15, "statistics_counters");
+}
+#endif
+
+#ifdef TWOWIRE_TRACE
+static void trace(uint32_t frequency)
+{
+    setup(frequency);
+    handler = [] { receiver.interruptVectorRoutine(); };
+    TwoWire::MasterConfig m{};
+    uint8_t data[2] = {0x20, 0x5A};
+    begin();
+    for (int i = 0; i < iterations; i++)
+    {
+        TwoWire::Trace::clear();
+        check(m.send(deviceAddress, data, sizeof(data)) == TwoWire::MStatus::Success, "trace");
+        check(m.probe(deviceAddress + 3) == TwoWire::MStatus::AddressNACK, "trace");
+        TwoWire::enableInterrupt();
+        receiver.receiveNextData();
+        TwoWire::Host::masterWrite(ownAddress, data, sizeof(data), true);
+        TwoWire::disableInterrupt();
+    }
+    report("trace", frequency, 2 * sizeof(data));
+    static const uint8_t expected[] = {
+        TW_START, TW_MT_SLA_ACK, TW_MT_DATA_ACK, TW_MT_DATA_ACK, TwoWire::Trace::STOP,
+        TW_REP_START, TW_MT_SLA_NACK, TwoWire::Trace::STOP,
+        TW_SR_SLA_ACK, TW_SR_DATA_ACK, TW_SR_DATA_ACK, TW_SR_STOP};
+    TwoWire::Trace::Event events[sizeof(expected)];
+    check(TwoWire::Trace::read(events, sizeof(expected)) == sizeof(expected), "trace");
+    bool ordered = true;
+    for (size_t i = 0; i < sizeof(expected); i++)
+    {
+        check(events[i].status == expected[i], "trace");
+        // 16 bit timestamps of a short sequence don't wrap
+        if (i > 0 && (uint16_t)(events[i].time - events[i - 1].time) > 10000)
+            ordered = false;
+    }
+    check(ordered && events[1].data == (deviceAddress << 1 | TW_WRITE) && events[10].data == data[1], "trace");
+    // Dump for extras/trace/decode (make -C extras/host trace)
+    if (frequency == 100000)
+    {
+        FILE *file = fopen("trace.txt", "w");
+        if (file != nullptr)
+        {
+            fprintf(file, "# tick_ns=%lu\n", (unsigned long)TwoWire::Trace::TICK_NS);
+            for (auto &e : events)
+                fprintf(file, "%02X %02X %04X\n", e.status, e.data, e.time);
+            fclose(file);
+        }
+    }
+    // Master without instrumentation doesn't record its commands
+    TwoWire::BasicMaster<> b{};
+    TwoWire::Trace::clear();
+    check(b.send(deviceAddress, data, sizeof(data)) == TwoWire::MStatus::Success, "trace_no_instrumentation");
+    check(TwoWire::Trace::read(events, sizeof(expected)) == 0, "trace_no_instrumentation");
+}
+#endif
+
+int main()
+{
+    printf("benchmark,frequency,bytes,register_reads,register_writes,events,time_us,bytes_per_s\n");
+    static const uint32_t frequencies[] = {100000, 400000};
+    for (uint32_t frequency : frequencies)
+    {
+        masterSend(frequency);
+        masterSendTimeout(frequency);
+        basicMasterSend(frequency);
+        basicMasterSendTimeout(frequency);
+        masterDeadline(frequency);
+        busRecovery(frequency);
+        masterReceiveRegister(frequency);
+        masterSendSegments(frequency);
+        masterReceiveSegments(frequency);
+        masterWriteRegister(frequency);
+        masterReceiveRegisterWide(frequency);
+        memoryDeviceWrite(frequency);
+        memoryCache(frequency);
+        registerCache(frequency);
+        masterAsyncReceiveRegister(frequency);
+        masterAsyncArbitration(frequency);
+        slaveReceive(frequency);
+        slaveReceivePingPong(frequency);
+        slaveReceiveFrames(frequency);
+        slaveTransmit(frequency);
+        slaveTransmitGenerator(frequency);
+        slaveTransmitChunks(frequency);
+        slaveTransmitSnapshots(frequency);
+        slaveRegisterMap(frequency);
+        slaveDispatcher(frequency);
+#ifdef TWOWIRE_STATISTICS
+        statistics(frequency);
+#endif
+#ifdef TWOWIRE_TRACE
+        trace(frequency);
+#endif
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// Minimal Arduino core for running the library on a host (see TwoWireHost.hpp)
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "TwoWireHost.hpp"
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define LOW 0x0
+#define HIGH 0x1
+
+#define SDA 18
+#define SCL 19
+
+#define ISR(vector, ...) extern "C" void vector(void)
+#define TWI_vect __vector_24
+
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+
+#define cli() TwoWire::Host::setInterruptsEnabled(false)
+#define sei() TwoWire::Host::setInterruptsEnabled(true)
+
+unsigned long micros();
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+long random(long howbig);
+long random(long howsmall, long howbig);
@@ -0,0 +1,10 @@
+#pragma once
+
+// Host replacement of <util/atomic.h> (see TwoWireHost.hpp)
+
+#include "TwoWireHost.hpp"
+
+#define ATOMIC_RESTORESTATE 0
+#define ATOMIC_FORCEON 1
+
+#define ATOMIC_BLOCK(type) for (TwoWire::Host::AtomicBlock _atomicBlock; _atomicBlock.enter();)
@@ -0,0 +1,78 @@
+#include <Arduino.h>
+
+#include <stdlib.h>
+
+// micros() on Timer1 (prescaler 8), like Arduino's micros() it costs an overflow interrupt
+static volatile uint16_t overflows = 0;
+
+ISR(TIMER1_OVF_vect)
+{
+    overflows++;
+}
+
+void init()
+{
+    TCCR1A = 0;
+    TCCR1B = _BV(CS11);
+    TIMSK1 = _BV(TOIE1);
+    sei();
+}
+
+unsigned long micros()
+{
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t high = overflows;
+    uint16_t low = TCNT1;
+    if ((TIFR1 & _BV(TOV1)) && low < 0x8000)
+        high++;
+    SREG = sreg;
+    return ((((uint32_t)high << 16) | low) * 8) / (F_CPU / 1000000UL);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    unsigned long t = micros();
+    while (micros() - t < us)
+    {
+    }
+}
+
+// Only SCL (PC5) and SDA (PC4) are used by the library
+static uint8_t _bit(uint8_t pin)
+{
+    return pin == SCL ? _BV(PC5) : _BV(PC4);
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (mode == OUTPUT)
+        DDRC |= _bit(pin);
+    else
+        DDRC &= ~_bit(pin);
+    if (mode == INPUT_PULLUP)
+        PORTC |= _bit(pin);
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    if (value)
+        PORTC |= _bit(pin);
+    else
+        PORTC &= ~_bit(pin);
+}
+
+int digitalRead(uint8_t pin)
+{
+    return (PINC & _bit(pin)) ? HIGH : LOW;
+}
+
+long random(long howbig)
+{
+    return howbig > 0 ? ::random() % howbig : 0;
+}
+
+long random(long howsmall, long howbig)
+{
+    return howsmall < howbig ? howsmall + random(howbig - howsmall) : howsmall;
+}
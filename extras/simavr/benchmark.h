@@ -0,0 +1,21 @@
+#pragma once
+
+// Shared between the benchmark firmware and the simavr harness
+
+// Benchmark markers are written to GPIOR0 (id when a benchmark starts, 0 when it ends)
+#define BENCH_MARKER GPIOR0
+#define BENCH_DONE 0xFF
+
+#define BENCH_OWN_ADDRESS 0x10
+#define BENCH_DEVICE_ADDRESS 0x50
+#define BENCH_SIZE 32
+
+enum
+{
+    BENCH_MASTER_SEND = 1,
+    BENCH_MASTER_RECEIVE,
+    BENCH_MASTER_ASYNC_SEND,
+    BENCH_SLAVE_RECEIVE,
+    BENCH_SLAVE_TRANSMIT,
+    BENCH_COUNT
+};
@@ -0,0 +1,125 @@
+// Benchmark firmware, every benchmark is delimited with markers the harness timestamps
+
+#include <Arduino.h>
+#include <TwoWire.hpp>
+
+#include <avr/sleep.h>
+#include <compat/twi.h>
+
+#include "benchmark.h"
+
+#ifndef BENCH_FREQUENCY
+#define BENCH_FREQUENCY 100000UL
+#endif
+
+static uint8_t data[BENCH_SIZE];
+
+static void (*handler)() = nullptr;
+static volatile bool finished = false;
+
+ISR(TWI_vect)
+{
+    // STOP and NACK of the last byte end the slave benchmarks
+    uint8_t status = TW_STATUS;
+    handler();
+    if (status == TW_SR_STOP || status == TW_ST_DATA_NACK)
+        finished = true;
+}
+
+static void mark(uint8_t benchmark)
+{
+    BENCH_MARKER = benchmark;
+}
+
+static void masterSend()
+{
+    TwoWire::MasterConfiguration m{};
+    m.signalStart();
+    m.addressForWriting(BENCH_DEVICE_ADDRESS);
+    mark(BENCH_MASTER_SEND);
+    m.sendData(data, BENCH_SIZE);
+    mark(0);
+    TwoWire::signalStop();
+}
+
+static void masterReceive()
+{
+    TwoWire::MasterConfiguration m{};
+    m.signalStart();
+    m.addressForReading(BENCH_DEVICE_ADDRESS);
+    mark(BENCH_MASTER_RECEIVE);
+    m.receiveData(data, BENCH_SIZE);
+    mark(0);
+    TwoWire::signalStop();
+}
+
+static TwoWire::MasterAsync async{};
+
+static void masterAsyncSend()
+{
+    handler = [] { async.interruptVectorRoutine(); };
+    TwoWire::enableInterrupt();
+    // (includes START, address and STOP)
+    mark(BENCH_MASTER_ASYNC_SEND);
+    async.send(BENCH_DEVICE_ADDRESS, data, BENCH_SIZE);
+    while (async.isBusy())
+    {
+    }
+    mark(0);
+    TwoWire::disableInterrupt();
+}
+
+static TwoWire::SlaveReceiver receiver{};
+
+static void slaveReceive()
+{
+    handler = [] { receiver.interruptVectorRoutine(); };
+    receiver.receiveNextData(data, BENCH_SIZE);
+    finished = false;
+    TwoWire::allowSlaveMode();
+    TwoWire::enableInterrupt();
+    mark(BENCH_SLAVE_RECEIVE);
+    while (!finished)
+    {
+    }
+    mark(0);
+    TwoWire::disableInterrupt();
+}
+
+static TwoWire::SlaveTransmitter transmitter{};
+
+static void slaveTransmit()
+{
+    handler = [] { transmitter.interruptVectorRoutine(); };
+    transmitter.transmitData(data, BENCH_SIZE);
+    finished = false;
+    TwoWire::allowSlaveMode();
+    TwoWire::enableInterrupt();
+    mark(BENCH_SLAVE_TRANSMIT);
+    while (!finished)
+    {
+    }
+    mark(0);
+    TwoWire::disableInterrupt();
+}
+
+int main()
+{
+    init();
+    TwoWire::init<BENCH_FREQUENCY>(BENCH_OWN_ADDRESS);
+    for (uint8_t i = 0; i < BENCH_SIZE; i++)
+        data[i] = i;
+
+    masterSend();
+    masterReceive();
+    masterAsyncSend();
+    slaveReceive();
+    slaveTransmit();
+
+    mark(BENCH_DONE);
+    // Sleeping with interrupts disabled ends the simulation
+    cli();
+    sleep_enable();
+    sleep_cpu();
+    return 0;
+}
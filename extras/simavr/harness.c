@@ -0,0 +1,289 @@
+// Runs the benchmark firmware under simavr with a simulated peer on the bus and reports
+// cycles per byte, ISR latency and SCL stretching per benchmark (CSV)
+//
+// Master benchmarks talk to a simulated slave device, slave benchmarks are driven by a
+// simulated master that clocks the next byte 9 bit times after the ISR cleared TWINT
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sim_avr.h>
+#include <sim_elf.h>
+#include <sim_io.h>
+#include <sim_irq.h>
+#include <sim_interrupts.h>
+#include <sim_cycle_timers.h>
+#include <avr_twi.h>
+
+#include "benchmark.h"
+
+// ATmega328P data space addresses
+#define GPIOR0_ADDRESS 0x3E
+#define TWBR_ADDRESS 0xB8
+#define TWSR_ADDRESS 0xB9
+#define TWCR_ADDRESS 0xBC
+#define TWINT_BIT 0x80
+#define TWI_VECTOR 24
+
+static const char *const names[BENCH_COUNT] = {
+    [BENCH_MASTER_SEND] = "master_send",
+    [BENCH_MASTER_RECEIVE] = "master_receive",
+    [BENCH_MASTER_ASYNC_SEND] = "master_async_send",
+    [BENCH_SLAVE_RECEIVE] = "slave_receive",
+    [BENCH_SLAVE_TRANSMIT] = "slave_transmit",
+};
+
+static const char *irqNames[2] = {
+    [TWI_IRQ_INPUT] = "8>peer.out",
+    [TWI_IRQ_OUTPUT] = "32<peer.in",
+};
+
+typedef struct
+{
+    uint32_t count;
+    avr_cycle_count_t total;
+    avr_cycle_count_t max;
+} sample_t;
+
+static avr_t *avr;
+static avr_irq_t *peer;
+static int failures = 0;
+static int done = 0;
+
+// Active benchmark (0 when none)
+static uint8_t benchmark = 0;
+static avr_cycle_count_t start;
+static uint32_t frequency;
+// TWI interrupt raised (TWINT set) and ISR entered, 0 when not pending
+static avr_cycle_count_t raised;
+static avr_cycle_count_t entered;
+// ISR entry to TWINT clear
+static sample_t latency;
+// TWINT set to TWINT clear (SCL held low)
+static sample_t stretch;
+
+// Simulated slave device
+static int selected = 0;
+static uint8_t next = 0;
+// Simulated master
+static uint32_t step = 0;
+
+static void sample(sample_t *s, avr_cycle_count_t cycles)
+{
+    s->count++;
+    s->total += cycles;
+    if (cycles > s->max)
+        s->max = cycles;
+}
+
+static double average(const sample_t *s)
+{
+    return s->count > 0 ? (double)s->total / s->count : 0.0;
+}
+
+static avr_cycle_count_t bitCycles()
+{
+    return avr->frequency / frequency;
+}
+
+static int isSlaveBenchmark()
+{
+    return benchmark == BENCH_SLAVE_RECEIVE || benchmark == BENCH_SLAVE_TRANSMIT;
+}
+
+static void send(uint8_t msg, uint8_t address, uint8_t data)
+{
+    avr_raise_irq(peer + TWI_IRQ_INPUT, avr_twi_irq_msg(msg, address, data));
+}
+
+static avr_cycle_count_t masterStep(avr_t *avr, avr_cycle_count_t when, void *param)
+{
+    (void)avr;
+    (void)param;
+    uint8_t address = (BENCH_OWN_ADDRESS << 1) | (benchmark == BENCH_SLAVE_TRANSMIT);
+    if (step == 0)
+    {
+        send(TWI_COND_START, address, 0);
+        step++;
+        // Address follows START without an interrupt
+        return when + bitCycles();
+    }
+    if (step == 1)
+        send(TWI_COND_ADDR, address, 0);
+    else if (step < 2 + BENCH_SIZE)
+    {
+        if (benchmark == BENCH_SLAVE_RECEIVE)
+            send(TWI_COND_WRITE, address, next++);
+        else
+            // Acknowledge every byte except the last one
+            send(TWI_COND_READ | (step < 1 + BENCH_SIZE ? TWI_COND_ACK : 0), address, 0);
+    }
+    else if (step == 2 + BENCH_SIZE)
+        send(TWI_COND_STOP, address, 0);
+    step++;
+    return 0;
+}
+
+static void peerHook(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    (void)irq;
+    (void)param;
+    avr_twi_msg_irq_t msg;
+    msg.u.v = value;
+    if (isSlaveBenchmark())
+    {
+        // Data our slave transmitter put on the bus
+        if (benchmark == BENCH_SLAVE_TRANSMIT && (msg.u.twi.msg & TWI_COND_READ))
+        {
+            if (msg.u.twi.data != next)
+                failures++;
+            next++;
+        }
+        return;
+    }
+    if (msg.u.twi.msg & TWI_COND_STOP)
+        selected = 0;
+    if (msg.u.twi.msg & TWI_COND_ADDR)
+    {
+        selected = (msg.u.twi.addr >> 1) == BENCH_DEVICE_ADDRESS;
+        if (selected)
+            send(TWI_COND_ACK, msg.u.twi.addr, 1);
+    }
+    if (selected && (msg.u.twi.msg & TWI_COND_WRITE))
+    {
+        if (msg.u.twi.data != next)
+            failures++;
+        next++;
+        send(TWI_COND_ACK, msg.u.twi.addr, 1);
+    }
+    if (selected && (msg.u.twi.msg & TWI_COND_READ))
+        send(TWI_COND_READ, msg.u.twi.addr, next++);
+}
+
+static void raisedHook(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    (void)irq;
+    (void)param;
+    if (value && benchmark != 0)
+        raised = avr->cycle;
+}
+
+static void enteredHook(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    (void)irq;
+    (void)param;
+    if (value && raised != 0)
+        entered = avr->cycle;
+}
+
+static void twcrHook(avr_t *avr, avr_io_addr_t addr, uint8_t v, void *param)
+{
+    (void)addr;
+    (void)param;
+    if (!(v & TWINT_BIT) || raised == 0)
+        return;
+    sample(&stretch, avr->cycle - raised);
+    if (entered != 0)
+        sample(&latency, avr->cycle - entered);
+    raised = 0;
+    entered = 0;
+    // Simulated master clocks the next byte (ACK bit included)
+    if (isSlaveBenchmark())
+        avr_cycle_timer_register(avr, 9 * bitCycles(), masterStep, NULL);
+}
+
+static void begin(uint8_t id)
+{
+    uint8_t twbr = avr->data[TWBR_ADDRESS];
+    uint8_t twps = avr->data[TWSR_ADDRESS] & 0x03;
+    frequency = avr->frequency / (16 + 2 * twbr * (1UL << (2 * twps)));
+    benchmark = id;
+    start = avr->cycle;
+    raised = 0;
+    entered = 0;
+    memset(&latency, 0, sizeof(latency));
+    memset(&stretch, 0, sizeof(stretch));
+    selected = 0;
+    next = 0;
+    step = 0;
+    if (isSlaveBenchmark())
+        avr_cycle_timer_register(avr, bitCycles(), masterStep, NULL);
+}
+
+static void end()
+{
+    avr_cycle_count_t cycles = avr->cycle - start;
+    double perByte = (double)cycles / BENCH_SIZE;
+    if (next != BENCH_SIZE)
+    {
+        fprintf(stderr, "%s: %u of %u bytes transferred\n", names[benchmark], next, BENCH_SIZE);
+        failures++;
+    }
+    printf("%s,%lu,%u,%llu,%.1f,%.1f,%.1f,%llu,%.1f,%llu,%.0f\n", names[benchmark], (unsigned long)frequency,
+        BENCH_SIZE, (unsigned long long)cycles, perByte, perByte - 9.0 * bitCycles(),
+        average(&latency), (unsigned long long)latency.max, average(&stretch), (unsigned long long)stretch.max,
+        BENCH_SIZE / ((double)cycles / avr->frequency));
+    benchmark = 0;
+}
+
+static void markerHook(avr_t *avr, avr_io_addr_t addr, uint8_t v, void *param)
+{
+    (void)param;
+    avr->data[addr] = v;
+    if (v == BENCH_DONE)
+        done = 1;
+    else if (v != 0 && v < BENCH_COUNT)
+        begin(v);
+    else if (v == 0 && benchmark != 0)
+        end();
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s firmware.elf [--header]\n", argv[0]);
+        return 2;
+    }
+
+    elf_firmware_t firmware;
+    memset(&firmware, 0, sizeof(firmware));
+    if (elf_read_firmware(argv[1], &firmware) != 0)
+    {
+        fprintf(stderr, "%s: cannot read firmware\n", argv[1]);
+        return 2;
+    }
+    avr = avr_make_mcu_by_name("atmega328p");
+    if (avr == NULL)
+        return 2;
+    avr_init(avr);
+    firmware.frequency = 16000000;
+    avr_load_firmware(avr, &firmware);
+
+    peer = avr_alloc_irq(&avr->irq_pool, 0, 2, irqNames);
+    avr_irq_register_notify(peer + TWI_IRQ_OUTPUT, peerHook, NULL);
+    avr_connect_irq(peer + TWI_IRQ_INPUT, avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT));
+    avr_connect_irq(avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT), peer + TWI_IRQ_OUTPUT);
+
+    avr_irq_t *vector = avr_get_interrupt_irq(avr, TWI_VECTOR);
+    avr_irq_register_notify(vector + AVR_INT_IRQ_PENDING, raisedHook, NULL);
+    avr_irq_register_notify(vector + AVR_INT_IRQ_RUNNING, enteredHook, NULL);
+    // (chained with the TWI module's own TWCR handler)
+    avr_register_io_write(avr, TWCR_ADDRESS, twcrHook, NULL);
+    avr_register_io_write(avr, GPIOR0_ADDRESS, markerHook, NULL);
+
+    if (argc > 2 && strcmp(argv[2], "--header") == 0)
+        printf("benchmark,frequency,bytes,cycles,cycles_per_byte,overhead_cycles_per_byte,"
+               "isr_latency_cycles,isr_latency_max_cycles,stretch_cycles,stretch_max_cycles,bytes_per_s\n");
+
+    int state = cpu_Running;
+    while (!done && state != cpu_Done && state != cpu_Crashed)
+        state = avr_run(avr);
+    if (state == cpu_Crashed)
+    {
+        fprintf(stderr, "%s: firmware crashed\n", argv[1]);
+        failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+// Minimal Arduino core for the simavr benchmark firmware (ATmega328P)
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define LOW 0x0
+#define HIGH 0x1
+
+#define SDA 18
+#define SCL 19
+
+void init();
+unsigned long micros();
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+long random(long howbig);
+long random(long howsmall, long howbig);
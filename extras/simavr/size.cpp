@@ -0,0 +1,62 @@
+// Smallest program using a single feature, built once per feature to measure its flash and RAM cost
+// (BENCH_FEATURE_NONE is the baseline)
+
+#include <Arduino.h>
+#include <TwoWire.hpp>
+
+static uint8_t data[4];
+
+#if defined(BENCH_FEATURE_MASTER_ASYNC)
+static TwoWire::MasterAsync async{};
+#elif defined(BENCH_FEATURE_SLAVE_RECEIVER)
+static TwoWire::SlaveReceiver receiver{data, sizeof(data)};
+#elif defined(BENCH_FEATURE_SLAVE_TRANSMITTER)
+static TwoWire::SlaveTransmitter transmitter{data, sizeof(data)};
+#endif
+
+#if defined(BENCH_FEATURE_MASTER_ASYNC) || defined(BENCH_FEATURE_SLAVE_RECEIVER) || defined(BENCH_FEATURE_SLAVE_TRANSMITTER)
+ISR(TWI_vect)
+{
+#if defined(BENCH_FEATURE_MASTER_ASYNC)
+    async.interruptVectorRoutine();
+#elif defined(BENCH_FEATURE_SLAVE_RECEIVER)
+    receiver.interruptVectorRoutine();
+#else
+    transmitter.interruptVectorRoutine();
+#endif
+}
+#endif
+
+int main()
+{
+    init();
+#if !defined(BENCH_FEATURE_NONE)
+    TwoWire::init<100000>(0x10);
+#endif
+#if defined(BENCH_FEATURE_MASTER_CONFIGURATION)
+    TwoWire::MasterConfiguration m{};
+    m.signalStart();
+    m.addressForWriting(0x50);
+    m.sendData(data, sizeof(data));
+    m.signalStopStart();
+    m.addressForReading(0x50);
+    m.receiveData(data, sizeof(data));
+    TwoWire::signalStop();
+#elif defined(BENCH_FEATURE_MASTER_CONFIG)
+    TwoWire::MasterConfig m{};
+    m.send(0x50, data, sizeof(data));
+    m.receiveRegister(0x50, 0x00, data, sizeof(data), true);
+#elif defined(BENCH_FEATURE_BASIC_MASTER)
+    TwoWire::BasicMaster<> m{};
+    m.send(0x50, data, sizeof(data));
+    m.receiveRegister(0x50, 0x00, data, sizeof(data), true);
+#elif defined(BENCH_FEATURE_MASTER_ASYNC)
+    async.receiveRegister(0x50, 0x00, data, sizeof(data), true);
+#elif defined(BENCH_FEATURE_SLAVE_RECEIVER) || defined(BENCH_FEATURE_SLAVE_TRANSMITTER)
+    TwoWire::enableInterrupt();
+#endif
+    while (true)
+    {
+        data[0]++;
+    }
+}
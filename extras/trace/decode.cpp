@@ -0,0 +1,339 @@
+// Decodes a dumped TwoWire trace (see docs/trace.cpp) into events, transactions and
+// a summary of where the bus time went
+//
+// Input is text, one event per line as three hex numbers: status data time
+// ("# tick_ns=4000" sets the length of a timestamp tick, other lines starting with # are ignored)
+//
+// Usage: decode [file] (reads stdin without a file)
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+// Markers of TwoWireTrace.hpp
+#define TRACE_TIMEOUT 0x01
+#define TRACE_STOP 0x02
+
+struct Event
+{
+    uint8_t status;
+    uint8_t data;
+    // Unwrapped time in nanoseconds
+    uint64_t time;
+    // Time since the previous event in nanoseconds
+    uint64_t delta;
+};
+
+enum Kind
+{
+    MasterWrite,
+    MasterRead,
+    MasterWriteRead,
+    SlaveReceive,
+    SlaveTransmit,
+    KindCount
+};
+
+static const char *const kindNames[KindCount] = {
+    "master write",
+    "master read",
+    "master write+read",
+    "slave receive",
+    "slave transmit",
+};
+
+struct Transaction
+{
+    bool master;
+    bool wrote;
+    bool read;
+    // Direction as slave (true when transmitting)
+    bool transmit;
+    uint8_t address;
+    uint32_t bytes;
+    uint64_t start;
+    uint64_t end;
+    const char *result;
+
+    Kind kind() const
+    {
+        if (!master)
+            return transmit ? SlaveTransmit : SlaveReceive;
+        if (wrote && read)
+            return MasterWriteRead;
+        return read ? MasterRead : MasterWrite;
+    }
+};
+
+static const char *describe(uint8_t status)
+{
+    switch (status)
+    {
+    case TRACE_TIMEOUT: return "timeout (TWINT never came)";
+    case TRACE_STOP: return "STOP requested";
+    case 0x00: return "bus error";
+    case 0x08: return "START";
+    case 0x10: return "repeated START";
+    case 0x18: return "SLA+W ACK";
+    case 0x20: return "SLA+W NACK";
+    case 0x28: return "data sent, ACK";
+    case 0x30: return "data sent, NACK";
+    case 0x38: return "arbitration lost";
+    case 0x40: return "SLA+R ACK";
+    case 0x48: return "SLA+R NACK";
+    case 0x50: return "data received, ACK returned";
+    case 0x58: return "data received, NACK returned";
+    case 0x60: return "addressed (SLA+W)";
+    case 0x68: return "arbitration lost, addressed (SLA+W)";
+    case 0x70: return "general call";
+    case 0x78: return "arbitration lost, general call";
+    case 0x80: return "slave data received, ACK returned";
+    case 0x88: return "slave data received, NACK returned";
+    case 0x90: return "general call data, ACK returned";
+    case 0x98: return "general call data, NACK returned";
+    case 0xA0: return "STOP or repeated START as slave";
+    case 0xA8: return "addressed (SLA+R)";
+    case 0xB0: return "arbitration lost, addressed (SLA+R)";
+    case 0xB8: return "slave data sent, ACK";
+    case 0xC0: return "slave data sent, NACK";
+    case 0xC8: return "last slave data sent, ACK";
+    case 0xF8: return "no information";
+    default: return "unknown";
+    }
+}
+
+static bool read(FILE *file, std::vector<Event> &events, uint64_t &tick)
+{
+    char line[256];
+    bool first = true;
+    uint16_t previous = 0;
+    uint64_t time = 0;
+    while (fgets(line, sizeof(line), file) != nullptr)
+    {
+        if (line[0] == '#')
+        {
+            const char *setting = strstr(line, "tick_ns=");
+            if (setting != nullptr)
+                tick = strtoull(setting + 8, nullptr, 10);
+            continue;
+        }
+        char *p = line;
+        char *end;
+        unsigned long values[3];
+        int count = 0;
+        for (; count < 3; count++)
+        {
+            values[count] = strtoul(p, &end, 16);
+            if (end == p)
+                break;
+            p = end;
+        }
+        if (count == 0)
+            continue;
+        if (count < 3)
+        {
+            fprintf(stderr, "malformed line: %s", line);
+            return false;
+        }
+        // Timestamps wrap around, gaps are assumed shorter than the wrap
+        uint16_t stamp = (uint16_t)values[2];
+        uint64_t delta = first ? 0 : (uint16_t)(stamp - previous);
+        time += delta;
+        previous = stamp;
+        first = false;
+        events.push_back({(uint8_t)values[0], (uint8_t)values[1], time, delta});
+    }
+    for (auto &e : events)
+    {
+        e.time *= tick;
+        e.delta *= tick;
+    }
+    return true;
+}
+
+static void decode(const std::vector<Event> &events, std::vector<Transaction> &transactions)
+{
+    bool active = false;
+    Transaction t{};
+    auto begin = [&](bool master, uint64_t time)
+    {
+        if (active)
+        {
+            t.end = time;
+            t.result = "unfinished";
+            transactions.push_back(t);
+        }
+        t = Transaction{};
+        t.master = master;
+        t.start = time;
+        t.result = "ok";
+        active = true;
+    };
+    auto finish = [&](uint64_t time, const char *result)
+    {
+        if (!active)
+            return;
+        t.end = time;
+        if (result != nullptr)
+            t.result = result;
+        transactions.push_back(t);
+        active = false;
+    };
+    for (auto &e : events)
+    {
+        switch (e.status)
+        {
+        case 0x08:
+            begin(true, e.time);
+            break;
+        case 0x10:
+            if (!active)
+                begin(true, e.time);
+            break;
+        case 0x18:
+        case 0x20:
+            t.address = e.data >> 1;
+            t.wrote = true;
+            if (e.status == 0x20)
+                t.result = "address NACK";
+            break;
+        case 0x40:
+        case 0x48:
+            t.address = e.data >> 1;
+            t.read = true;
+            if (e.status == 0x48)
+                t.result = "address NACK";
+            break;
+        case 0x28:
+        case 0x50:
+        case 0x58:
+            t.bytes++;
+            break;
+        case 0x30:
+            t.bytes++;
+            t.result = "data NACK";
+            break;
+        case 0x38:
+            finish(e.time, "arbitration lost");
+            break;
+        case 0x68:
+        case 0x78:
+        case 0xB0:
+            finish(e.time, "arbitration lost");
+            // fall through
+        case 0x60:
+        case 0x70:
+        case 0xA8:
+            begin(false, e.time);
+            t.transmit = e.status == 0xA8 || e.status == 0xB0;
+            t.address = e.status == 0x70 || e.status == 0x78 ? 0 : e.data >> 1;
+            break;
+        case 0x80:
+        case 0x90:
+        case 0xB8:
+            t.bytes++;
+            break;
+        case 0x88:
+        case 0x98:
+        case 0xC0:
+            t.bytes++;
+            finish(e.time, nullptr);
+            break;
+        case 0xC8:
+            t.bytes++;
+            finish(e.time, "master wanted more");
+            break;
+        case 0xA0:
+        case TRACE_STOP:
+            finish(e.time, nullptr);
+            break;
+        case TRACE_TIMEOUT:
+            finish(e.time, "timeout");
+            break;
+        case 0x00:
+            finish(e.time, "bus error");
+            break;
+        default:
+            break;
+        }
+    }
+    if (active)
+        finish(events.back().time, "unfinished");
+}
+
+int main(int argc, char **argv)
+{
+    FILE *file = stdin;
+    if (argc > 1 && (file = fopen(argv[1], "r")) == nullptr)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    // Timer0 of a 16 MHz Arduino
+    uint64_t tick = 4000;
+    std::vector<Event> events;
+    if (!read(file, events, tick))
+        return 1;
+    if (events.empty())
+    {
+        fprintf(stderr, "no events\n");
+        return 1;
+    }
+
+    printf("== Events ==\n");
+    printf("%12s %12s  status data  event\n", "time_us", "delta_us");
+    for (auto &e : events)
+        printf("%12.1f %12.1f  0x%02X   0x%02X  %s\n", e.time / 1000.0, e.delta / 1000.0, e.status, e.data, describe(e.status));
+
+    std::vector<Transaction> transactions;
+    decode(events, transactions);
+    printf("\n== Transactions ==\n");
+    printf("%12s %12s  %-18s %-7s %6s  result\n", "start_us", "duration_us", "type", "address", "bytes");
+    for (auto &t : transactions)
+        printf("%12.1f %12.1f  %-18s 0x%02X    %6u  %s\n", t.start / 1000.0, (t.end - t.start) / 1000.0,
+            kindNames[t.kind()], t.address, t.bytes, t.result);
+
+    // Time within transactions per type, the rest of the traced span was idle (or between traced events)
+    uint64_t span = events.back().time - events.front().time;
+    uint64_t busy = 0;
+    printf("\n== Bus time ==\n");
+    printf("%-18s %6s %8s %12s %12s %7s\n", "type", "count", "bytes", "total_us", "per_byte_us", "share");
+    for (int k = 0; k < KindCount; k++)
+    {
+        uint32_t count = 0;
+        uint32_t bytes = 0;
+        uint64_t time = 0;
+        for (auto &t : transactions)
+        {
+            if (t.kind() != k)
+                continue;
+            count++;
+            bytes += t.bytes;
+            time += t.end - t.start;
+        }
+        if (count == 0)
+            continue;
+        busy += time;
+        printf("%-18s %6u %8u %12.1f %12.1f %6.1f%%\n", kindNames[k], count, bytes, time / 1000.0,
+            bytes > 0 ? time / 1000.0 / bytes : 0.0, span > 0 ? 100.0 * time / span : 0.0);
+    }
+    uint64_t idle = span > busy ? span - busy : 0;
+    printf("%-18s %6s %8s %12.1f %12s %6.1f%%\n", "idle", "", "", idle / 1000.0, "", span > 0 ? 100.0 * idle / span : 0.0);
+
+    // Longest waits point at slow slaves, clock stretching or a busy main loop
+    std::vector<size_t> slowest;
+    for (size_t i = 1; i < events.size(); i++)
+        slowest.push_back(i);
+    std::sort(slowest.begin(), slowest.end(), [&](size_t a, size_t b) { return events[a].delta > events[b].delta; });
+    if (slowest.size() > 5)
+        slowest.resize(5);
+    printf("\n== Longest gaps ==\n");
+    for (size_t i : slowest)
+        printf("%12.1f us before %s (0x%02X) at %.1f us\n", events[i].delta / 1000.0, describe(events[i].status),
+            events[i].status, events[i].time / 1000.0);
+    return 0;
+}
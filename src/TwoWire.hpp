@@ -1,17 +1,41 @@
 #pragma once
 
 #include "TwoWireCore.hpp"
+#include "TwoWireDeadline.hpp"
+#include "TwoWireBusRecovery.hpp"
+#include "TwoWireMasterPrimitives.hpp"
+#include "TwoWireMasterPolicy.hpp"
+#include "TwoWireMasterInstrumentation.hpp"
 #include "TwoWireMasterConfiguration.hpp"
+#include "TwoWireBasicMaster.hpp"
 #include "TwoWireMasterConfig.hpp"
+#include "TwoWireMasterAsync.hpp"
+#include "TwoWireMemoryDevice.hpp"
+#include "TwoWireMemoryCache.hpp"
+#include "TwoWireRegisterCache.hpp"
+#include "TwoWireStatusTable.hpp"
+#include "TwoWireStatistics.hpp"
+#include "TwoWireTrace.hpp"
 #include "TwoWireSlave.hpp"
 #include "TwoWireSlaveReceiver.hpp"
+#include "TwoWireSlaveFrameReceiver.hpp"
 #include "TwoWireSlaveTransmitter.hpp"
+#include "TwoWireSlaveRegisterMap.hpp"
+#include "TwoWireSlaveDispatcher.hpp"
+#include "TwoWireArbitrationManager.hpp"
 
 namespace TwoWire
 {
     // Master enums
     using MStatus = TwoWire::MasterConfiguration::Status;
     using MBusLostBehaviour = TwoWire::MasterConfig::BusLostBehaviour;
+    using MBackoff = TwoWire::MasterConfig::Backoff;
+    using MByteOrder = TwoWire::MasterConfig::ByteOrder;
+    // Bus recovery enums
+    using RResult = TwoWire::BusRecovery::Result;
+    // Master segments
+    using MSendSegment = TwoWire::MasterConfiguration::SendSegment;
+    using MReceiveSegment = TwoWire::MasterConfiguration::ReceiveSegment;
     // Slave enums
     using SBasicStatus = TwoWire::Slave::BasicStatus;
     using SStatus = TwoWire::Slave::Status;
@@ -0,0 +1,71 @@
+#include "TwoWireArbitrationManager.hpp"
+
+#include "TwoWireStatusTable.hpp"
+
+#include "TwoWireRegisters.hpp"
+#include <util/atomic.h>
+
+using namespace TwoWire;
+
+ArbitrationManager::ArbitrationManager(MasterAsync &master, const SlaveDispatcher::Handler &slave, uint8_t retries)
+    : master(master), slave(slave), statistics()
+{
+    master.setArbitrationRetries(retries);
+}
+
+ArbitrationManager::ArbitrationManager(MasterAsync &master, const SlaveDispatcher::Handler &slave)
+    : ArbitrationManager(master, slave, 8)
+{
+}
+
+ArbitrationManager::Statistics ArbitrationManager::getStatistics()
+{
+    Statistics s;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        s = statistics;
+    }
+    return s;
+}
+
+void ArbitrationManager::resetStatistics()
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        statistics = Statistics();
+    }
+}
+
+void ArbitrationManager::interruptVectorRoutine()
+{
+    uint8_t status = TW_STATUS;
+    switch (status)
+    {
+    case TW_MT_ARB_LOST:
+        statistics.arbitrationLost++;
+        break;
+    case TW_SR_ARB_LOST_SLA_ACK:
+    case TW_SR_ARB_LOST_GCALL_ACK:
+    case TW_ST_ARB_LOST_SLA_ACK:
+        statistics.arbitrationLost++;
+        statistics.addressedAsSlave++;
+        break;
+    default:
+        break;
+    }
+    if (master.interruptVectorRoutine())
+        return;
+    // Serve the other master right away so it doesn't wait on a stretched bus
+    if (slave.routine != nullptr)
+        slave.routine(slave.object);
+    else if (!StatusTable::applyAction(status))
+        TWCR = TWCR_W(_BV(TWINT));
+    if (StatusTable::endsSlaveTransaction(status))
+    {
+        statistics.slaveTransactions++;
+        if (master.isSuspended())
+            statistics.resumed++;
+        // START waits until the other master releases the bus
+        master.resume();
+    }
+}
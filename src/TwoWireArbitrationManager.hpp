@@ -0,0 +1,69 @@
+#pragma once
+
+#include "TwoWireMasterAsync.hpp"
+#include "TwoWireSlaveDispatcher.hpp"
+
+namespace TwoWire
+{
+    class ArbitrationManager
+    {
+    public:
+        struct Statistics
+        {
+            // Number of times the bus was lost to another master
+            uint16_t arbitrationLost;
+            // Number of times the master was addressed as slave while transmitting
+            uint16_t addressedAsSlave;
+            // Number of finished slave transactions
+            uint16_t slaveTransactions;
+            // Number of suspended master transactions resumed after a slave transaction
+            uint16_t resumed;
+        };
+
+    private:
+        MasterAsync &master;
+        SlaveDispatcher::Handler slave;
+        Statistics statistics;
+
+    public:
+        /**
+         * @brief Create arbitration manager sharing the TWI between master and slave role
+         *  (lost transactions are restarted, when addressed the slave handler gets the bus right away
+         *  and the interrupted transaction is resumed before the queued ones once the slave transaction ends)
+         *
+         * @param master Asynchronous master
+         * @param slave Slave handler (SlaveDispatcher::handler(receiver), SlaveDispatcher::handler(dispatcher), ...)
+         * @param retries Number of restarts per transaction after losing arbitration
+         */
+        ArbitrationManager(MasterAsync &master, const SlaveDispatcher::Handler &slave, uint8_t retries);
+
+        /**
+         * @brief Create arbitration manager sharing the TWI between master and slave role
+         *  (transaction is restarted at most 8 times)
+         *
+         * @param master Asynchronous master
+         * @param slave Slave handler
+         */
+        ArbitrationManager(MasterAsync &master, const SlaveDispatcher::Handler &slave);
+
+        /**
+         * @brief Get arbitration statistics
+         *
+         * @return Statistics Statistics since creation or the last reset
+         */
+        Statistics getStatistics();
+
+        /**
+         * @brief Reset arbitration statistics
+         *
+         */
+        void resetStatistics();
+
+        /**
+         * @brief Function to be called in TWI Interrupt Service Routine
+         *  (replaces the routines of the master and the slave)
+         *
+         */
+        void interruptVectorRoutine();
+    };
+}
@@ -0,0 +1,870 @@
+#pragma once
+
+#include "TwoWireCore.hpp"
+#include "TwoWireMasterPrimitives.hpp"
+#include "TwoWireMasterPolicy.hpp"
+#include "TwoWireStatusTable.hpp"
+
+namespace TwoWire
+{
+    /**
+     * @brief Master whose features are selected at compile time
+     *  (e.g. BasicMaster<> only polls TWINT and returns the first failure, MasterConfig is the instantiation with everything set at runtime)
+     *
+     * @tparam TimeoutPolicy MasterPolicy::NoTimeout, MasterPolicy::FixedTimeout<timeout> or MasterPolicy::RuntimeTimeout
+     * @tparam BusLostPolicy MasterPolicy::FixedBusLost<behaviour> or MasterPolicy::RuntimeBusLost
+     * @tparam ErrorPolicy MasterPolicy::NoRetry or MasterPolicy::RuntimeRetry
+     * @tparam Instrumentation MasterPolicy::NoInstrumentation or MasterPolicy::StatisticsInstrumentation
+     */
+    template <class TimeoutPolicy = MasterPolicy::NoTimeout,
+        class BusLostPolicy = MasterPolicy::FixedBusLost<MasterPolicy::BusLostBehaviour::Abort>,
+        class ErrorPolicy = MasterPolicy::NoRetry,
+        class Instrumentation = MasterPolicy::NoInstrumentation>
+    class BasicMaster : protected MasterPrimitives, public TimeoutPolicy, public BusLostPolicy, public ErrorPolicy, public Instrumentation
+    {
+    public:
+        using MasterPrimitives::Status;
+        using MasterPrimitives::SendSegment;
+        using MasterPrimitives::ReceiveSegment;
+        using MasterPrimitives::ByteOrder;
+        using MasterPrimitives::RegisterAddress;
+
+    protected:
+        template <class D>
+        bool _serveSlave(D &d);
+
+        template <class D>
+        bool _handleBadStatus(Status s, D &d, bool extendable, uint8_t attempts);
+
+        template <class D>
+        Status _send(D &d, uint8_t address, uint8_t data, bool stop);
+        template <class D>
+        Status _send(D &d, uint8_t address, const uint8_t *data, size_t size, bool stop);
+        template <class D>
+        Status _send(D &d, uint8_t address, const SendSegment *segments, size_t count, bool stop);
+
+        template <class D>
+        Status _receive(D &d, uint8_t address, uint8_t *data, bool stop);
+        template <class D>
+        Status _receive(D &d, uint8_t address, uint8_t *data, size_t size, bool stop);
+        template <class D>
+        Status _receive(D &d, uint8_t address, const ReceiveSegment *segments, size_t count, bool stop);
+
+        template <class D>
+        Status _receiveRegister(D &d, uint8_t address, uint8_t registerAddress, uint8_t *data, bool repeatStart, bool stop);
+        template <class D>
+        Status _receiveRegister(D &d, uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop);
+        template <class D>
+        Status _receiveRegister(D &d, uint8_t address, const uint8_t *registerAddress, uint8_t registerSize, uint8_t *data, size_t size, bool repeatStart, bool stop);
+
+        template <class D>
+        Status _writeRegister(D &d, uint8_t address, const uint8_t *registerAddress, uint8_t registerSize, const uint8_t *data, size_t size, bool stop);
+
+        template <class D>
+        Status _probe(D &d, uint8_t address, bool stop);
+    public:
+        /**
+         * @brief Create Basic Master
+         *
+         * @param timeout Timeout policy (e.g. timeout in microseconds for MasterPolicy::RuntimeTimeout)
+         * @param busLost Bus lost policy (e.g. behaviour for MasterPolicy::RuntimeBusLost)
+         */
+        BasicMaster(const TimeoutPolicy &timeout, const BusLostPolicy &busLost);
+
+        /**
+         * @brief Create Basic Master
+         *
+         * @param timeout Timeout policy (e.g. timeout in microseconds for MasterPolicy::RuntimeTimeout)
+         */
+        BasicMaster(const TimeoutPolicy &timeout);
+
+        /**
+         * @brief Create Basic Master
+         *
+         */
+        BasicMaster();
+
+        /**
+         * @brief Send data to slave device at address
+         *
+         * @param address Address of the slave device
+         * @param data Data to send
+         * @param stop Whether to release the bus on completion
+         * @param deadline Deadline shared by a sequence of operations (optional, timeout is used otherwise)
+         * @return Status Status of the function
+         */
+        Status send(uint8_t address, uint8_t data, bool stop);
+        Status send(uint8_t address, uint8_t data, bool stop, Deadline &deadline);
+        Status send(uint8_t address, uint8_t data);
+        Status send(uint8_t address, const uint8_t *data, size_t size, bool stop);
+        Status send(uint8_t address, const uint8_t *data, size_t size, bool stop, Deadline &deadline);
+        Status send(uint8_t address, const uint8_t *data, size_t size);
+
+        /**
+         * @brief Send data of multiple segments to slave device at address
+         *  (segments are sent in a single transaction without copying, e.g. header and payload)
+         *
+         * @param address Address of the slave device
+         * @param segments Segments to send
+         * @param count Number of segments
+         * @param stop Whether to release the bus on completion
+         * @param deadline Deadline shared by a sequence of operations (optional, timeout is used otherwise)
+         * @return Status Status of the function
+         */
+        Status send(uint8_t address, const SendSegment *segments, size_t count, bool stop);
+        Status send(uint8_t address, const SendSegment *segments, size_t count, bool stop, Deadline &deadline);
+        Status send(uint8_t address, const SendSegment *segments, size_t count);
+
+        /**
+         * @brief Receive data from slave device at address
+         *
+         * @param address Address of the slave device
+         * @param data Where to receive the data
+         * @param stop Whether to release the bus on completion
+         * @param deadline Deadline shared by a sequence of operations (optional, timeout is used otherwise)
+         * @return Status Status of the function
+         */
+        Status receive(uint8_t address, uint8_t *data, bool stop);
+        Status receive(uint8_t address, uint8_t *data, bool stop, Deadline &deadline);
+        Status receive(uint8_t address, uint8_t *data);
+        Status receive(uint8_t address, uint8_t *data, size_t size, bool stop);
+        Status receive(uint8_t address, uint8_t *data, size_t size, bool stop, Deadline &deadline);
+        Status receive(uint8_t address, uint8_t *data, size_t size);
+
+        /**
+         * @brief Receive data from slave device at address into multiple segments
+         *  (segments are filled in order in a single transaction, e.g. header and payload)
+         *
+         * @param address Address of the slave device
+         * @param segments Segments to fill
+         * @param count Number of segments
+         * @param stop Whether to release the bus on completion
+         * @param deadline Deadline shared by a sequence of operations (optional, timeout is used otherwise)
+         * @return Status Status of the function
+         */
+        Status receive(uint8_t address, const ReceiveSegment *segments, size_t count, bool stop);
+        Status receive(uint8_t address, const ReceiveSegment *segments, size_t count, bool stop, Deadline &deadline);
+        Status receive(uint8_t address, const ReceiveSegment *segments, size_t count);
+
+        /**
+         * @brief Receive slave device register contents
+         *
+         * @param address Address of the slave device
+         * @param registerAddress Address of the slave device register
+         * @param data Where to receive the data
+         * @param repeatStart Does the device support repeat start (or should stop start be used)
+         * @param stop Whether to release the bus on completion
+         * @param deadline Deadline shared by a sequence of operations (optional, timeout is used otherwise)
+         * @return Status Status of the function
+         */
+        Status receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, bool repeatStart, bool stop);
+        Status receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, bool repeatStart, bool stop, Deadline &deadline);
+        Status receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, bool repeatStart);
+        Status receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop);
+        Status receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop, Deadline &deadline);
+        Status receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart);
+
+        /**
+         * @brief Receive contents of slave device register with a multi-byte address
+         *  (register address size and byte order are selected at compile time, e.g. receiveRegister<2, ByteOrder::BigEndian>)
+         *
+         * @tparam registerSize Size of the register address in bytes (1, 2 or 4)
+         * @tparam order Byte order of the register address
+         * @param address Address of the slave device
+         * @param registerAddress Address of the slave device register
+         * @param data Where to receive the data
+         * @param size Size of the data
+         * @param repeatStart Does the device support repeat start (or should stop start be used)
+         * @param stop Whether to release the bus on completion
+         * @param deadline Deadline shared by a sequence of operations (optional, timeout is used otherwise)
+         * @return Status Status of the function
+         */
+        template <uint8_t registerSize, ByteOrder order>
+        Status receiveRegister(uint8_t address, uint32_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop);
+        template <uint8_t registerSize, ByteOrder order>
+        Status receiveRegister(uint8_t address, uint32_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop, Deadline &deadline);
+        template <uint8_t registerSize, ByteOrder order>
+        Status receiveRegister(uint8_t address, uint32_t registerAddress, uint8_t *data, size_t size, bool repeatStart);
+
+        /**
+         * @brief Receive contents of slave device register with an already encoded address
+         *  (for register address size known only at runtime)
+         *
+         * @param address Address of the slave device
+         * @param registerAddress Register address bytes in bus order
+         * @param registerSize Number of register address bytes
+         * @param data Where to receive the data
+         * @param size Size of the data
+         * @param repeatStart Does the device support repeat start (or should stop start be used)
+         * @param stop Whether to release the bus on completion
+         * @param deadline Deadline shared by a sequence of operations (optional, timeout is used otherwise)
+         * @return Status Status of the function
+         */
+        Status receiveRegister(uint8_t address, const uint8_t *registerAddress, uint8_t registerSize, uint8_t *data, size_t size, bool repeatStart, bool stop);
+        Status receiveRegister(uint8_t address, const uint8_t *registerAddress, uint8_t registerSize, uint8_t *data, size_t size, bool repeatStart, bool stop, Deadline &deadline);
+
+        /**
+         * @brief Write slave device register contents
+         *  (register address and data are sent in a single transaction)
+         *
+         * @param address Address of the slave device
+         * @param registerAddress Address of the slave device register
+         * @param data Data to write
+         * @param size Size of the data
+         * @param stop Whether to release the bus on completion
+         * @param deadline Deadline shared by a sequence of operations (optional, timeout is used otherwise)
+         * @return Status Status of the function
+         */
+        Status writeRegister(uint8_t address, uint8_t registerAddress, uint8_t data, bool stop);
+        Status writeRegister(uint8_t address, uint8_t registerAddress, uint8_t data, bool stop, Deadline &deadline);
+        Status writeRegister(uint8_t address, uint8_t registerAddress, uint8_t data);
+        Status writeRegister(uint8_t address, uint8_t registerAddress, const uint8_t *data, size_t size, bool stop);
+        Status writeRegister(uint8_t address, uint8_t registerAddress, const uint8_t *data, size_t size, bool stop, Deadline &deadline);
+        Status writeRegister(uint8_t address, uint8_t registerAddress, const uint8_t *data, size_t size);
+
+        /**
+         * @brief Write slave device register contents with a multi-byte address
+         *  (register address size and byte order are selected at compile time, e.g. writeRegister<2, ByteOrder::BigEndian>)
+         *
+         * @tparam registerSize Size of the register address in bytes (1, 2 or 4)
+         * @tparam order Byte order of the register address
+         * @param address Address of the slave device
+         * @param registerAddress Address of the slave device register
+         * @param data Data to write
+         * @param size Size of the data
+         * @param stop Whether to release the bus on completion
+         * @param deadline Deadline shared by a sequence of operations (optional, timeout is used otherwise)
+         * @return Status Status of the function
+         */
+        template <uint8_t registerSize, ByteOrder order>
+        Status writeRegister(uint8_t address, uint32_t registerAddress, const uint8_t *data, size_t size, bool stop);
+        template <uint8_t registerSize, ByteOrder order>
+        Status writeRegister(uint8_t address, uint32_t registerAddress, const uint8_t *data, size_t size, bool stop, Deadline &deadline);
+        template <uint8_t registerSize, ByteOrder order>
+        Status writeRegister(uint8_t address, uint32_t registerAddress, const uint8_t *data, size_t size);
+
+        /**
+         * @brief Write slave device register contents with an already encoded address
+         *  (for register address size known only at runtime)
+         *
+         * @param address Address of the slave device
+         * @param registerAddress Register address bytes in bus order
+         * @param registerSize Number of register address bytes
+         * @param data Data to write
+         * @param size Size of the data
+         * @param stop Whether to release the bus on completion
+         * @param deadline Deadline shared by a sequence of operations (optional, timeout is used otherwise)
+         * @return Status Status of the function
+         */
+        Status writeRegister(uint8_t address, const uint8_t *registerAddress, uint8_t registerSize, const uint8_t *data, size_t size, bool stop);
+        Status writeRegister(uint8_t address, const uint8_t *registerAddress, uint8_t registerSize, const uint8_t *data, size_t size, bool stop, Deadline &deadline);
+
+        /**
+         * @brief Check whether slave device at address acknowledges its address
+         *  (sends only SLA+W, used for device detection and acknowledge polling)
+         *
+         * @param address Address of the slave device
+         * @param stop Whether to release the bus on completion
+         * @param deadline Deadline shared by a sequence of operations (optional, timeout is used otherwise)
+         * @return Status Success if the device acknowledged, AddressNACK if it didn't
+         */
+        Status probe(uint8_t address, bool stop);
+        Status probe(uint8_t address, bool stop, Deadline &deadline);
+        Status probe(uint8_t address);
+    };
+
+    // Template definitions
+
+#define BASIC_MASTER_TEMPLATE template <class TimeoutPolicy, class BusLostPolicy, class ErrorPolicy, class Instrumentation>
+#define BASIC_MASTER BasicMaster<TimeoutPolicy, BusLostPolicy, ErrorPolicy, Instrumentation>
+
+#define CHECK_RETURN_STATUS(expression) \
+    if ((s = (expression)) != Status::Success) \
+        return s
+
+// Every operation takes the slave address as its first argument
+#define RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(deadline, extendable, type, function, address, ...) \
+    Status s; \
+    uint8_t attempts = 0; \
+    Instrumentation::_beginTransaction(); \
+    do \
+    { \
+        s = function(deadline, address, ##__VA_ARGS__); \
+        if (attempts < UINT8_MAX) \
+            attempts++; \
+    } while (s != Status::Success && _handleBadStatus(s, deadline, extendable, attempts)); \
+    this->_setAttempts(attempts); \
+    Instrumentation::_endTransaction(Statistics::Transaction::type, address, s, attempts); \
+    return s
+
+#define RETURN_EXECUTE_RETRIED_FUNCTION(type, function, address, ...) \
+    auto d = this->_deadline(); \
+    RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(d, true, type, function, address, ##__VA_ARGS__)
+
+    BASIC_MASTER_TEMPLATE
+    BASIC_MASTER::BasicMaster(const TimeoutPolicy &timeout, const BusLostPolicy &busLost)
+        : TimeoutPolicy(timeout), BusLostPolicy(busLost), ErrorPolicy(), Instrumentation()
+    {
+    }
+
+    BASIC_MASTER_TEMPLATE
+    BASIC_MASTER::BasicMaster(const TimeoutPolicy &timeout)
+        : TimeoutPolicy(timeout), BusLostPolicy(), ErrorPolicy(), Instrumentation()
+    {
+    }
+
+    BASIC_MASTER_TEMPLATE
+    BASIC_MASTER::BasicMaster()
+        : TimeoutPolicy(), BusLostPolicy(), ErrorPolicy(), Instrumentation()
+    {
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    bool BASIC_MASTER::_serveSlave(D &d)
+    {
+        while (true)
+        {
+            uint8_t status = TW_STATUS;
+            this->_callSlaveHandler();
+            if (StatusTable::endsSlaveTransaction(status))
+                return true;
+            // Wait for the other master
+            if (_awaitTWINT<Instrumentation>(d))
+                return false;
+        }
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    bool BASIC_MASTER::_handleBadStatus(Status s, D &d, bool extendable, uint8_t attempts)
+    {
+        // Constant false without a retrying error policy, only the bus is released then
+        bool retry = this->_retriesOn(s) && this->_hasAttemptsLeft(attempts);
+        switch (s)
+        {
+        case Status::BusLost:
+            switch (this->_getBusLostBehaviour())
+            {
+            case MasterPolicy::BusLostBehaviour::RetryExtendingTimeout:
+                // Deadline given by the caller is never extended
+                if (extendable)
+                    d.restart();
+                break;
+            case MasterPolicy::BusLostBehaviour::RetryWithinTimeout:
+                break;
+            case MasterPolicy::BusLostBehaviour::Abort:
+                retry = false;
+                break;
+            }
+            // On retry START is sent once the bus is free
+            if (!retry)
+                TWCR |= _BV(TWINT);
+            break;
+        case Status::AddressNACK:
+        case Status::DataNACK:
+            _signalStop<Instrumentation>();
+            break;
+        case Status::Timeout:
+            // Release the bus (also cancels a START still waiting for it), then free it if a slave holds it
+            _signalStop<Instrumentation>();
+            this->_recoverBus();
+            // Every retried attempt gets its own timeout (unless the deadline was given by the caller),
+            // without an attempt limit the restarted deadline would retry forever
+            if (!extendable || !this->_hasAttemptLimit())
+                retry = false;
+            else if (retry)
+                d.restart();
+            break;
+        case Status::AddressedAsSlave:
+            // Serve the other master, then start over once it releases the bus
+            retry = this->_hasSlaveHandler() && _serveSlave(d) && this->_hasAttemptsLeft(attempts);
+            break;
+        case Status::Error:
+            clearError();
+            this->_recoverBus();
+            break;
+        default:
+            break;
+        }
+        // Attempt can't start after the deadline
+        if (retry && d.isExpired())
+            retry = false;
+        if (retry)
+            this->_backoff(d.getRemaining(), attempts);
+        return retry;
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    MasterPrimitives::Status BASIC_MASTER::_send(D &d, uint8_t address, uint8_t data, bool stop)
+    {
+        Status s;
+        // Send START condition and check status
+        CHECK_RETURN_STATUS(_signalStart<Instrumentation>(d));
+        // Send SLA+W and check status
+        CHECK_RETURN_STATUS(_addressSlaveW<Instrumentation>(d, address));
+        // Send data and check status
+        CHECK_RETURN_STATUS(_sendData<Instrumentation>(d, data));
+        // If stop is set, release bus
+        if (stop)
+            _signalStop<Instrumentation>();
+        // Return success
+        return Status::Success;
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    MasterPrimitives::Status BASIC_MASTER::_send(D &d, uint8_t address, const uint8_t *data, size_t size, bool stop)
+    {
+        Status s;
+        // Send START condition and check status
+        CHECK_RETURN_STATUS(_signalStart<Instrumentation>(d));
+        // Send SLA+W and check status
+        CHECK_RETURN_STATUS(_addressSlaveW<Instrumentation>(d, address));
+        // Send data and check status
+        CHECK_RETURN_STATUS(_sendData<Instrumentation>(d, data, size));
+        // If stop is set, release bus
+        if (stop)
+            _signalStop<Instrumentation>();
+        // Return success
+        return Status::Success;
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    MasterPrimitives::Status BASIC_MASTER::_send(D &d, uint8_t address, const SendSegment *segments, size_t count, bool stop)
+    {
+        Status s;
+        // Send START condition and check status
+        CHECK_RETURN_STATUS(_signalStart<Instrumentation>(d));
+        // Send SLA+W and check status
+        CHECK_RETURN_STATUS(_addressSlaveW<Instrumentation>(d, address));
+        // Send data and check status
+        CHECK_RETURN_STATUS(_sendData<Instrumentation>(d, segments, count));
+        // If stop is set, release bus
+        if (stop)
+            _signalStop<Instrumentation>();
+        // Return success
+        return Status::Success;
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    MasterPrimitives::Status BASIC_MASTER::_receive(D &d, uint8_t address, uint8_t *data, bool stop)
+    {
+        Status s;
+        // Send START condition and check status
+        CHECK_RETURN_STATUS(_signalStart<Instrumentation>(d));
+        // Send SLA+R and check status
+        CHECK_RETURN_STATUS(_addressSlaveR<Instrumentation>(d, address));
+        // Read data and check status
+        CHECK_RETURN_STATUS(_receiveData<Instrumentation>(d, data));
+        // If stop is set, release bus
+        if (stop)
+            _signalStop<Instrumentation>();
+        // Return success
+        return Status::Success;
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    MasterPrimitives::Status BASIC_MASTER::_receive(D &d, uint8_t address, uint8_t *data, size_t size, bool stop)
+    {
+        Status s;
+        // Send START condition and check status
+        CHECK_RETURN_STATUS(_signalStart<Instrumentation>(d));
+        // Send SLA+R and check status
+        CHECK_RETURN_STATUS(_addressSlaveR<Instrumentation>(d, address));
+        // Read data and check status
+        CHECK_RETURN_STATUS(_receiveData<Instrumentation>(d, data, size));
+        // If stop is set, release bus
+        if (stop)
+            _signalStop<Instrumentation>();
+        // Return success
+        return Status::Success;
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    MasterPrimitives::Status BASIC_MASTER::_receive(D &d, uint8_t address, const ReceiveSegment *segments, size_t count, bool stop)
+    {
+        Status s;
+        // Send START condition and check status
+        CHECK_RETURN_STATUS(_signalStart<Instrumentation>(d));
+        // Send SLA+R and check status
+        CHECK_RETURN_STATUS(_addressSlaveR<Instrumentation>(d, address));
+        // Read data and check status
+        CHECK_RETURN_STATUS(_receiveData<Instrumentation>(d, segments, count));
+        // If stop is set, release bus
+        if (stop)
+            _signalStop<Instrumentation>();
+        // Return success
+        return Status::Success;
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    MasterPrimitives::Status BASIC_MASTER::_receiveRegister(D &d, uint8_t address, uint8_t registerAddress, uint8_t *data, bool repeatStart, bool stop)
+    {
+        Status s;
+        // Send START condition and check status
+        CHECK_RETURN_STATUS(_signalStart<Instrumentation>(d));
+        // Send SLA+W and check status
+        CHECK_RETURN_STATUS(_addressSlaveW<Instrumentation>(d, address));
+        // Send data and check status
+        CHECK_RETURN_STATUS(_sendData<Instrumentation>(d, registerAddress));
+        // Restart or StopStart
+        CHECK_RETURN_STATUS(repeatStart ? _signalStart<Instrumentation>(d) : _signalStopStart<Instrumentation>(d));
+        // Send SLA+R and check status
+        CHECK_RETURN_STATUS(_addressSlaveR<Instrumentation>(d, address));
+        // Read data and check status
+        CHECK_RETURN_STATUS(_receiveData<Instrumentation>(d, data));
+        // If stop is set, release bus
+        if (stop)
+            _signalStop<Instrumentation>();
+        // Return success
+        return Status::Success;
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    MasterPrimitives::Status BASIC_MASTER::_receiveRegister(D &d, uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop)
+    {
+        return _receiveRegister(d, address, &registerAddress, 1, data, size, repeatStart, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    MasterPrimitives::Status BASIC_MASTER::_receiveRegister(D &d, uint8_t address, const uint8_t *registerAddress, uint8_t registerSize, uint8_t *data, size_t size, bool repeatStart, bool stop)
+    {
+        Status s;
+        // Send START condition and check status
+        CHECK_RETURN_STATUS(_signalStart<Instrumentation>(d));
+        // Send SLA+W and check status
+        CHECK_RETURN_STATUS(_addressSlaveW<Instrumentation>(d, address));
+        // Send register address and check status
+        CHECK_RETURN_STATUS(_sendData<Instrumentation>(d, registerAddress, registerSize));
+        // Restart or StopStart
+        CHECK_RETURN_STATUS(repeatStart ? _signalStart<Instrumentation>(d) : _signalStopStart<Instrumentation>(d));
+        // Send SLA+R and check status
+        CHECK_RETURN_STATUS(_addressSlaveR<Instrumentation>(d, address));
+        // Read data and check status
+        CHECK_RETURN_STATUS(_receiveData<Instrumentation>(d, data, size));
+        // If stop is set, release bus
+        if (stop)
+            _signalStop<Instrumentation>();
+        // Return success
+        return Status::Success;
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    MasterPrimitives::Status BASIC_MASTER::_writeRegister(D &d, uint8_t address, const uint8_t *registerAddress, uint8_t registerSize, const uint8_t *data, size_t size, bool stop)
+    {
+        Status s;
+        // Send START condition and check status
+        CHECK_RETURN_STATUS(_signalStart<Instrumentation>(d));
+        // Send SLA+W and check status
+        CHECK_RETURN_STATUS(_addressSlaveW<Instrumentation>(d, address));
+        // Send register address and check status
+        CHECK_RETURN_STATUS(_sendData<Instrumentation>(d, registerAddress, registerSize));
+        // Send data and check status
+        CHECK_RETURN_STATUS(_sendData<Instrumentation>(d, data, size));
+        // If stop is set, release bus
+        if (stop)
+            _signalStop<Instrumentation>();
+        // Return success
+        return Status::Success;
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <class D>
+    MasterPrimitives::Status BASIC_MASTER::_probe(D &d, uint8_t address, bool stop)
+    {
+        Status s;
+        // Send START condition and check status
+        CHECK_RETURN_STATUS(_signalStart<Instrumentation>(d));
+        // Send SLA+W and check status
+        CHECK_RETURN_STATUS(_addressSlaveW<Instrumentation>(d, address));
+        // If stop is set, release bus
+        if (stop)
+            _signalStop<Instrumentation>();
+        // Return success
+        return Status::Success;
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::send(uint8_t address, uint8_t data, bool stop)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION(Send, _send, address, data, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::send(uint8_t address, uint8_t data, bool stop, Deadline &deadline)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(deadline, false, Send, _send, address, data, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::send(uint8_t address, uint8_t data)
+    {
+        return send(address, data, true);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::send(uint8_t address, const uint8_t *data, size_t size, bool stop)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION(Send, _send, address, data, size, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::send(uint8_t address, const uint8_t *data, size_t size, bool stop, Deadline &deadline)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(deadline, false, Send, _send, address, data, size, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::send(uint8_t address, const uint8_t *data, size_t size)
+    {
+        return send(address, data, size, true);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::send(uint8_t address, const SendSegment *segments, size_t count, bool stop)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION(Send, _send, address, segments, count, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::send(uint8_t address, const SendSegment *segments, size_t count, bool stop, Deadline &deadline)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(deadline, false, Send, _send, address, segments, count, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::send(uint8_t address, const SendSegment *segments, size_t count)
+    {
+        return send(address, segments, count, true);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receive(uint8_t address, uint8_t *data, bool stop)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION(Receive, _receive, address, data, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receive(uint8_t address, uint8_t *data, bool stop, Deadline &deadline)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(deadline, false, Receive, _receive, address, data, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receive(uint8_t address, uint8_t *data)
+    {
+        return receive(address, data, true);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receive(uint8_t address, uint8_t *data, size_t size, bool stop)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION(Receive, _receive, address, data, size, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receive(uint8_t address, uint8_t *data, size_t size, bool stop, Deadline &deadline)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(deadline, false, Receive, _receive, address, data, size, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receive(uint8_t address, uint8_t *data, size_t size)
+    {
+        return receive(address, data, size, true);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receive(uint8_t address, const ReceiveSegment *segments, size_t count, bool stop)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION(Receive, _receive, address, segments, count, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receive(uint8_t address, const ReceiveSegment *segments, size_t count, bool stop, Deadline &deadline)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(deadline, false, Receive, _receive, address, segments, count, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receive(uint8_t address, const ReceiveSegment *segments, size_t count)
+    {
+        return receive(address, segments, count, true);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, bool repeatStart, bool stop)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION(ReceiveRegister, _receiveRegister, address, registerAddress, data, repeatStart, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, bool repeatStart, bool stop, Deadline &deadline)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(deadline, false, ReceiveRegister, _receiveRegister, address, registerAddress, data, repeatStart, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, bool repeatStart)
+    {
+        return receiveRegister(address, registerAddress, data, repeatStart, true);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION(ReceiveRegister, _receiveRegister, address, registerAddress, data, size, repeatStart, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop, Deadline &deadline)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(deadline, false, ReceiveRegister, _receiveRegister, address, registerAddress, data, size, repeatStart, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart)
+    {
+        return receiveRegister(address, registerAddress, data, size, repeatStart, true);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receiveRegister(uint8_t address, const uint8_t *registerAddress, uint8_t registerSize, uint8_t *data, size_t size, bool repeatStart, bool stop)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION(ReceiveRegister, _receiveRegister, address, registerAddress, registerSize, data, size, repeatStart, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::receiveRegister(uint8_t address, const uint8_t *registerAddress, uint8_t registerSize, uint8_t *data, size_t size, bool repeatStart, bool stop, Deadline &deadline)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(deadline, false, ReceiveRegister, _receiveRegister, address, registerAddress, registerSize, data, size, repeatStart, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::writeRegister(uint8_t address, uint8_t registerAddress, uint8_t data, bool stop)
+    {
+        return writeRegister(address, registerAddress, &data, 1, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::writeRegister(uint8_t address, uint8_t registerAddress, uint8_t data, bool stop, Deadline &deadline)
+    {
+        return writeRegister(address, registerAddress, &data, 1, stop, deadline);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::writeRegister(uint8_t address, uint8_t registerAddress, uint8_t data)
+    {
+        return writeRegister(address, registerAddress, data, true);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::writeRegister(uint8_t address, uint8_t registerAddress, const uint8_t *data, size_t size, bool stop)
+    {
+        return writeRegister(address, &registerAddress, 1, data, size, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::writeRegister(uint8_t address, uint8_t registerAddress, const uint8_t *data, size_t size, bool stop, Deadline &deadline)
+    {
+        return writeRegister(address, &registerAddress, 1, data, size, stop, deadline);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::writeRegister(uint8_t address, uint8_t registerAddress, const uint8_t *data, size_t size)
+    {
+        return writeRegister(address, registerAddress, data, size, true);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::writeRegister(uint8_t address, const uint8_t *registerAddress, uint8_t registerSize, const uint8_t *data, size_t size, bool stop)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION(WriteRegister, _writeRegister, address, registerAddress, registerSize, data, size, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::writeRegister(uint8_t address, const uint8_t *registerAddress, uint8_t registerSize, const uint8_t *data, size_t size, bool stop, Deadline &deadline)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(deadline, false, WriteRegister, _writeRegister, address, registerAddress, registerSize, data, size, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::probe(uint8_t address, bool stop)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION(Probe, _probe, address, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::probe(uint8_t address, bool stop, Deadline &deadline)
+    {
+        RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN(deadline, false, Probe, _probe, address, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    MasterPrimitives::Status BASIC_MASTER::probe(uint8_t address)
+    {
+        return probe(address, true);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <uint8_t registerSize, MasterPrimitives::ByteOrder order>
+    MasterPrimitives::Status BASIC_MASTER::receiveRegister(uint8_t address, uint32_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop)
+    {
+        RegisterAddress<registerSize, order> r{registerAddress};
+        return receiveRegister(address, r.bytes, registerSize, data, size, repeatStart, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <uint8_t registerSize, MasterPrimitives::ByteOrder order>
+    MasterPrimitives::Status BASIC_MASTER::receiveRegister(uint8_t address, uint32_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop, Deadline &deadline)
+    {
+        RegisterAddress<registerSize, order> r{registerAddress};
+        return receiveRegister(address, r.bytes, registerSize, data, size, repeatStart, stop, deadline);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <uint8_t registerSize, MasterPrimitives::ByteOrder order>
+    MasterPrimitives::Status BASIC_MASTER::receiveRegister(uint8_t address, uint32_t registerAddress, uint8_t *data, size_t size, bool repeatStart)
+    {
+        return receiveRegister<registerSize, order>(address, registerAddress, data, size, repeatStart, true);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <uint8_t registerSize, MasterPrimitives::ByteOrder order>
+    MasterPrimitives::Status BASIC_MASTER::writeRegister(uint8_t address, uint32_t registerAddress, const uint8_t *data, size_t size, bool stop)
+    {
+        RegisterAddress<registerSize, order> r{registerAddress};
+        return writeRegister(address, r.bytes, registerSize, data, size, stop);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <uint8_t registerSize, MasterPrimitives::ByteOrder order>
+    MasterPrimitives::Status BASIC_MASTER::writeRegister(uint8_t address, uint32_t registerAddress, const uint8_t *data, size_t size, bool stop, Deadline &deadline)
+    {
+        RegisterAddress<registerSize, order> r{registerAddress};
+        return writeRegister(address, r.bytes, registerSize, data, size, stop, deadline);
+    }
+
+    BASIC_MASTER_TEMPLATE
+    template <uint8_t registerSize, MasterPrimitives::ByteOrder order>
+    MasterPrimitives::Status BASIC_MASTER::writeRegister(uint8_t address, uint32_t registerAddress, const uint8_t *data, size_t size)
+    {
+        return writeRegister<registerSize, order>(address, registerAddress, data, size, true);
+    }
+
+#undef RETURN_EXECUTE_RETRIED_FUNCTION
+#undef RETURN_EXECUTE_RETRIED_FUNCTION_WITHIN
+#undef CHECK_RETURN_STATUS
+#undef BASIC_MASTER
+#undef BASIC_MASTER_TEMPLATE
+}
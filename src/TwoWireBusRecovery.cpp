@@ -0,0 +1,121 @@
+#include "TwoWireBusRecovery.hpp"
+
+#include "TwoWireDeadline.hpp"
+
+#include "TwoWireRegisters.hpp"
+#include <Arduino.h>
+
+using namespace TwoWire;
+
+BusRecovery::BusRecovery(uint32_t frequency, bool pullup)
+    : halfPeriod(frequency > 500000 / MAX_HALF_PERIOD ? (500000 + frequency - 1) / frequency : MAX_HALF_PERIOD), pullup(pullup), recoveries(0),
+      report{Result::Recovered, 0, false, 0}
+{
+}
+
+BusRecovery::BusRecovery()
+    : BusRecovery(100000, false)
+{
+}
+
+void BusRecovery::_release(uint8_t pin)
+{
+    // Open drain, line is pulled up while the pin is an input
+    pinMode(pin, INPUT);
+    if (pullup)
+        digitalWrite(pin, HIGH);
+}
+
+void BusRecovery::_drive(uint8_t pin)
+{
+    // Low first, so the pin never drives the line high
+    digitalWrite(pin, LOW);
+    pinMode(pin, OUTPUT);
+}
+
+bool BusRecovery::_awaitClock()
+{
+    Deadline d{CLOCK_STRETCH_LIMIT};
+    while (!digitalRead(SCL))
+    {
+        if (d.isExpired())
+            return false;
+    }
+    return true;
+}
+
+void BusRecovery::_wait()
+{
+    delayMicroseconds(halfPeriod);
+}
+
+bool BusRecovery::isBusIdle()
+{
+    return digitalRead(SCL) && digitalRead(SDA);
+}
+
+BusRecovery::Report BusRecovery::recover()
+{
+    uint32_t start = micros();
+    Report r{Result::Recovered, 0, false, 0};
+    // Settings to restore once the bus is free
+    uint8_t address = TWAR;
+    uint8_t addressMask = TWAMR;
+    uint8_t bitRate = TWBR;
+    uint8_t prescaler = TWSR & (_BV(TWPS1) | _BV(TWPS0));
+    uint8_t control = TWCR & (_BV(TWEA) | _BV(TWEN) | _BV(TWIE));
+    // Disabling TWI hands the pins over to the port and resets its state machine
+    TWCR = 0;
+    _release(SDA);
+    _release(SCL);
+    r.dataWasHeld = !digitalRead(SDA);
+    bool clock = _awaitClock();
+    // Every pulse lets the slave shift out one more bit, it lets go of SDA on a one or at the acknowledge
+    while (clock && !digitalRead(SDA) && r.pulses < MAX_PULSES)
+    {
+        _drive(SCL);
+        _wait();
+        _release(SCL);
+        clock = _awaitClock();
+        _wait();
+        r.pulses++;
+    }
+    if (clock)
+    {
+        // STOP (SDA rises while SCL is high) resets the slaves
+        _drive(SCL);
+        _wait();
+        _drive(SDA);
+        _wait();
+        _release(SCL);
+        clock = _awaitClock();
+        _wait();
+        _release(SDA);
+        _wait();
+    }
+    if (!clock || !digitalRead(SCL))
+        r.result = Result::ClockHeld;
+    else if (!digitalRead(SDA))
+        r.result = Result::DataHeld;
+    TWAR = address;
+    TWAMR = addressMask;
+    TWBR = bitRate;
+    TWSR = prescaler;
+    TWCR = control;
+    uint32_t duration = micros() - start;
+    r.duration = duration < UINT16_MAX ? duration : UINT16_MAX;
+    report = r;
+    if (recoveries < UINT16_MAX)
+        recoveries++;
+    return r;
+}
+
+BusRecovery::Report BusRecovery::getLastReport()
+{
+    return report;
+}
+
+uint16_t BusRecovery::getRecoveryCount()
+{
+    return recoveries;
+}
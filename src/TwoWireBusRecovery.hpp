@@ -0,0 +1,101 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace TwoWire
+{
+    class BusRecovery
+    {
+    public:
+        enum class Result : int8_t
+        {
+            // Both lines are released
+            Recovered,
+            // SCL is held low by another device (no pulses can be clocked out)
+            ClockHeld,
+            // SDA is still held low after the pulses and STOP
+            DataHeld
+        };
+
+        struct Report
+        {
+            // Outcome of the recovery
+            Result result;
+            // Number of SCL pulses clocked out
+            uint8_t pulses;
+            // Whether SDA was held low before the recovery
+            bool dataWasHeld;
+            // Duration of the recovery in microseconds
+            uint16_t duration;
+        };
+
+        // Slave holding SDA releases it within a byte and its acknowledge
+        static constexpr uint8_t MAX_PULSES = 9;
+        // Longest SCL stretch waited for after releasing SCL in microseconds
+        static constexpr uint16_t CLOCK_STRETCH_LIMIT = 1000;
+        // Longest half period of the SCL pulses in microseconds (delayMicroseconds is only accurate up to 16383 us)
+        static constexpr uint16_t MAX_HALF_PERIOD = 16383;
+
+    private:
+        uint16_t halfPeriod;
+        bool pullup;
+        uint16_t recoveries;
+        Report report;
+
+        void _release(uint8_t pin);
+
+        void _drive(uint8_t pin);
+
+        bool _awaitClock();
+
+        void _wait();
+
+    public:
+        /**
+         * @brief Create bus recovery
+         *
+         * @param frequency Frequency of the SCL pulses (below 31 Hz the half period is clamped to MAX_HALF_PERIOD)
+         * @param pullup Whether the internal pull-ups are used (see activatePullup)
+         */
+        BusRecovery(uint32_t frequency, bool pullup);
+
+        /**
+         * @brief Create bus recovery
+         *  (pulses at 100 kHz, external pull-ups)
+         *
+         */
+        BusRecovery();
+
+        /**
+         * @brief Check whether both SCL and SDA are released
+         *
+         * @return true Bus is idle
+         * @return false Bus is held by some device
+         */
+        static bool isBusIdle();
+
+        /**
+         * @brief Free the bus held by a slave that lost track of the transaction
+         *  (TWI is disabled, up to MAX_PULSES pulses are clocked out on SCL until SDA is released followed by STOP,
+         *  then TWI is enabled again with its previous address, frequency and control settings)
+         *
+         * @return Report What happened during the recovery
+         */
+        Report recover();
+
+        /**
+         * @brief Get report of the last recovery
+         *
+         * @return Report Report of the last recovery
+         */
+        Report getLastReport();
+
+        /**
+         * @brief Get number of recoveries since creation
+         *
+         * @return uint16_t Number of recoveries
+         */
+        uint16_t getRecoveryCount();
+    };
+}
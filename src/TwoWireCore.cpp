@@ -1,13 +1,12 @@
 #include "TwoWire.hpp"
 
-#include <compat/twi.h>
+#include "TwoWireRegisters.hpp"
 
 void TwoWire::init(uint8_t address, uint32_t frequency)
 {
     setAddress(address);
 
-    setBaseFrequency(frequency);
-    setFrequencyPrescaler(BitRatePrescaler::x1);
+    setFrequency(frequency);
 
     enable();
 }
@@ -49,7 +48,22 @@ void TwoWire::setBaseFrequency(uint32_t frequency)
 
 void TwoWire::setFrequencyPrescaler(BitRatePrescaler prescaler)
 {
-    TWSR |= ((uint8_t)prescaler) & (_BV(TWPS1) | _BV(TWPS0));
+    TWSR = (TWSR & ~(_BV(TWPS1) | _BV(TWPS0))) | (((uint8_t)prescaler) & (_BV(TWPS1) | _BV(TWPS0)));
+}
+
+void TwoWire::setFrequency(const FrequencyPlan &plan)
+{
+    TWBR = plan.bitRate;
+    setFrequencyPrescaler(plan.prescaler);
+}
+
+bool TwoWire::setFrequency(uint32_t frequency)
+{
+    auto plan = planFrequency(frequency);
+    if (!plan.valid)
+        return false;
+    setFrequency(plan);
+    return true;
 }
 
 uint32_t TwoWire::getBaseFrequency()
@@ -59,7 +73,7 @@ uint32_t TwoWire::getBaseFrequency()
 
 uint32_t TwoWire::getFrequency()
 {
-    return F_CPU / (16 + 2 * TWBR * (TWSR & (_BV(TWPS1) | _BV(TWPS0))));
+    return F_CPU / (16 + 2 * TWBR * ((uint32_t)1 << (2 * (TWSR & (_BV(TWPS1) | _BV(TWPS0))))));
 }
 
 void TwoWire::allowSlaveMode()
@@ -114,6 +128,7 @@ void TwoWire::deactivatePullup()
 
 void TwoWire::signalStop()
 {
+    Trace::_record(Trace::STOP);
     TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTO));
 }
 
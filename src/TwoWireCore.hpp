@@ -1,9 +1,8 @@
 #pragma once
 
-#include <stdint.h>
+#include "TwoWireRegisters.hpp"
 
-#define TWCR_UNUSED (TWCR & (_BV(TWEA) | _BV(TWWC) | _BV(TWEN) | _BV(TWIE)))
-#define TWCR_W(d) ((d) | TWCR_UNUSED)
+#include <stdint.h>
 
 namespace TwoWire
 {
@@ -21,6 +20,85 @@ namespace TwoWire
      */
     static constexpr auto DEFAULT_FREQUENCY = 100000;
 
+    struct FrequencyPlan
+    {
+        // Value of TWBR
+        uint8_t bitRate;
+        // Value of TWPS
+        BitRatePrescaler prescaler;
+        // Whether the requested frequency is achievable
+        bool valid;
+
+        /**
+         * @brief Get frequency achieved by the plan
+         *
+         * @return uint32_t Achieved frequency
+         */
+        constexpr uint32_t getFrequency() const
+        {
+            return F_CPU / (16 + 2 * (uint32_t)bitRate * ((uint32_t)1 << (2 * (uint8_t)prescaler)));
+        }
+
+        /**
+         * @brief Get difference between the achieved and the requested frequency
+         *  (planned frequency never exceeds the requested one so the error is never positive)
+         *
+         * @param frequency Requested frequency
+         * @return int32_t Achieved frequency minus requested frequency
+         */
+        constexpr int32_t getError(uint32_t frequency) const
+        {
+            return (int32_t)getFrequency() - (int32_t)frequency;
+        }
+    };
+
+    constexpr uint32_t _ceilDivide(uint32_t a, uint32_t b)
+    {
+        return (a + b - 1) / b;
+    }
+
+    constexpr uint32_t _planBitRate(uint32_t cycles, uint8_t prescaler)
+    {
+        return cycles <= 16 ? 0 : _ceilDivide(cycles - 16, (uint32_t)2 << (2 * prescaler));
+    }
+
+    constexpr FrequencyPlan _planFrequency(uint32_t cycles, uint8_t prescaler)
+    {
+        return _planBitRate(cycles, prescaler) <= 0xFF
+            ? FrequencyPlan{(uint8_t)_planBitRate(cycles, prescaler), (BitRatePrescaler)prescaler, true}
+            : prescaler < (uint8_t)BitRatePrescaler::x64
+                ? _planFrequency(cycles, prescaler + 1)
+                : FrequencyPlan{0xFF, BitRatePrescaler::x64, false};
+    }
+
+    /**
+     * @brief Plan TWBR and TWPS for the frequency
+     *  (picks the smallest prescaler for best resolution and never exceeds the requested frequency)
+     *
+     * @param frequency Requested frequency
+     * @return FrequencyPlan Register values (check valid)
+     */
+    constexpr FrequencyPlan planFrequency(uint32_t frequency)
+    {
+        return frequency == 0 || frequency > F_CPU / 16
+            ? FrequencyPlan{0, BitRatePrescaler::x1, false}
+            : _planFrequency(_ceilDivide(F_CPU, frequency), (uint8_t)BitRatePrescaler::x1);
+    }
+
+    /**
+     * @brief Plan TWBR and TWPS for the frequency at compile time
+     *  (fails to compile if the frequency is not achievable)
+     *
+     * @tparam frequency Requested frequency
+     * @return FrequencyPlan Register values
+     */
+    template <uint32_t frequency>
+    constexpr FrequencyPlan planFrequency()
+    {
+        static_assert(planFrequency(frequency).valid, "TwoWire frequency is not achievable with current F_CPU");
+        return planFrequency(frequency);
+    }
+
     /**
      * @brief Enable TWI interface and initialize required parameters
      *
@@ -29,6 +107,16 @@ namespace TwoWire
      */
     void init(uint8_t address, uint32_t frequency = DEFAULT_FREQUENCY);
 
+    /**
+     * @brief Enable TWI interface and initialize required parameters
+     *  (frequency is planned at compile time)
+     *
+     * @tparam frequency Frequency of the TWI
+     * @param address Address of the TWI
+     */
+    template <uint32_t frequency>
+    void init(uint8_t address);
+
     /**
      * @brief Enable TWI interface
      *
@@ -84,6 +172,35 @@ namespace TwoWire
      */
     void setFrequencyPrescaler(BitRatePrescaler prescaler);
 
+    /**
+     * @brief Set TwoWire frequency (bit rate and prescaler) from a plan
+     *
+     * @param plan Planned register values
+     */
+    void setFrequency(const FrequencyPlan &plan);
+
+    /**
+     * @brief Set TwoWire frequency choosing the best prescaler
+     *
+     * @param frequency Frequency
+     * @return true Frequency was set
+     * @return false Frequency is not achievable (nothing is changed)
+     */
+    bool setFrequency(uint32_t frequency);
+
+    /**
+     * @brief Set TwoWire frequency planned at compile time
+     *  (no runtime division)
+     *
+     * @tparam frequency Frequency
+     */
+    template <uint32_t frequency>
+    void setFrequency()
+    {
+        constexpr FrequencyPlan plan = planFrequency<frequency>();
+        setFrequency(plan);
+    }
+
     /**
      * @brief Get current TwoWire frequency (excluding the prescaler)
      *
@@ -178,4 +295,14 @@ namespace TwoWire
      * 
      */
     void clearErrorIfSet();
+
+    template <uint32_t frequency>
+    void init(uint8_t address)
+    {
+        setAddress(address);
+
+        setFrequency<frequency>();
+
+        enable();
+    }
 }
@@ -0,0 +1,34 @@
+#include "TwoWireDeadline.hpp"
+
+#include <Arduino.h>
+
+using namespace TwoWire;
+
+Deadline::Deadline(uint32_t budget)
+    : start(budget != UNLIMITED ? micros() : 0), budget(budget)
+{
+}
+
+Deadline::Deadline()
+    : Deadline(UNLIMITED)
+{
+}
+
+void Deadline::restart()
+{
+    if (budget != UNLIMITED)
+        start = micros();
+}
+
+uint32_t Deadline::getRemaining() const
+{
+    if (budget == UNLIMITED)
+        return UNLIMITED;
+    uint32_t elapsed = getElapsed();
+    return elapsed < budget ? budget - elapsed : 0;
+}
+
+uint32_t Deadline::getElapsed() const
+{
+    return (uint32_t)micros() - start;
+}
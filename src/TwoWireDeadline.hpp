@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace TwoWire
+{
+    class Deadline
+    {
+    public:
+        // Budget of a deadline that never expires
+        static constexpr uint32_t UNLIMITED = (uint32_t)(-1);
+
+    private:
+        uint32_t start;
+        uint32_t budget;
+
+    public:
+        /**
+         * @brief Create deadline starting now
+         *  (pass the same deadline to a sequence of operations to bound them all together)
+         *
+         * @param budget Time until the deadline in microseconds (UNLIMITED for no deadline)
+         */
+        explicit Deadline(uint32_t budget);
+
+        /**
+         * @brief Create deadline that never expires
+         *
+         */
+        Deadline();
+
+        /**
+         * @brief Start the budget again from now
+         *
+         */
+        void restart();
+
+        /**
+         * @brief Check whether the deadline never expires
+         *
+         * @return true Budget is unlimited
+         * @return false Budget is limited
+         */
+        bool isUnlimited() const
+        {
+            // Inline so TWINT polling doesn't call out for it
+            return budget == UNLIMITED;
+        }
+
+        /**
+         * @brief Check whether the deadline has passed
+         *
+         * @return true Budget is used up
+         * @return false Budget is left
+         */
+        bool isExpired() const
+        {
+            // micros() is called only for a limited budget
+            return budget != UNLIMITED && getElapsed() > budget;
+        }
+
+        /**
+         * @brief Get time left until the deadline
+         *
+         * @return uint32_t Remaining time in microseconds (0 if expired, UNLIMITED if the budget is unlimited)
+         */
+        uint32_t getRemaining() const;
+
+        /**
+         * @brief Get time since the deadline was started
+         *
+         * @return uint32_t Elapsed time in microseconds (only meaningful for a limited budget)
+         */
+        uint32_t getElapsed() const;
+    };
+
+    /**
+     * @brief Deadline that never expires, known at compile time
+     *  (operations using it only poll TWINT, micros() is never called)
+     *
+     */
+    class NoDeadline
+    {
+    public:
+        void restart()
+        {
+        }
+
+        constexpr bool isUnlimited() const
+        {
+            return true;
+        }
+
+        constexpr bool isExpired() const
+        {
+            return false;
+        }
+
+        constexpr uint32_t getRemaining() const
+        {
+            return Deadline::UNLIMITED;
+        }
+
+        constexpr uint32_t getElapsed() const
+        {
+            return 0;
+        }
+    };
+}
@@ -0,0 +1,347 @@
+#include "TwoWireMasterAsync.hpp"
+
+#include "TwoWireRegisters.hpp"
+#include <util/atomic.h>
+
+using namespace TwoWire;
+
+using Status = MasterAsync::Status;
+
+MasterAsync::MasterAsync(Transaction *queue, size_t capacity)
+    : transaction(), queue(queue), capacity(capacity), head(0), pending(0),
+      count(0), registerSent(false), twea(0), held(false), busy(false), started(false), suspended(false),
+      arbitrationRetries(0), arbitrationLosses(0), status(Status::Success)
+{
+}
+
+MasterAsync::MasterAsync()
+    : MasterAsync(nullptr, 0)
+{
+}
+
+void MasterAsync::_prepare(const Transaction &transaction)
+{
+    this->transaction = transaction;
+    count = 0;
+    registerSent = false;
+    arbitrationLosses = 0;
+    busy = true;
+    started = false;
+}
+
+void MasterAsync::_restart()
+{
+    // Transaction starts over from its START
+    count = 0;
+    registerSent = false;
+    arbitrationLosses++;
+    started = false;
+}
+
+void MasterAsync::_begin()
+{
+    // Remember TWEA so slave mode is restored after the transaction
+    twea = TWCR & _BV(TWEA);
+    held = false;
+    // Send START condition (or repeated START if the bus is still held)
+    TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTA) | _BV(TWIE));
+}
+
+bool MasterAsync::_push(const Transaction &transaction)
+{
+    if (pending >= capacity)
+        return false;
+    size_t tail = head + pending;
+    if (tail >= capacity)
+        tail -= capacity;
+    queue[tail] = transaction;
+    pending++;
+    return true;
+}
+
+void MasterAsync::_next()
+{
+    _prepare(queue[head]);
+    head = head + 1 < capacity ? head + 1 : 0;
+    pending--;
+}
+
+void MasterAsync::_finish(Status s, uint8_t twcr)
+{
+    Callback callback = transaction.callback;
+    void *context = transaction.context;
+    status = s;
+    busy = false;
+    uint8_t cleared = _BV(TWEA);
+    if (pending > 0)
+    {
+        // Chain next transaction straight from the interrupt
+        // (START after STOP if the bus was released, otherwise repeated START)
+        _next();
+        twcr |= _BV(TWINT) | _BV(TWSTA) | _BV(TWIE);
+    }
+    else if (!(twcr & _BV(TWINT)))
+    {
+        // Bus is held with TWINT left set, the interrupt would fire again right away
+        // (START of the next transaction enables it again)
+        cleared |= _BV(TWIE);
+        held = true;
+    }
+    // Apply follow-up action and restore TWEA
+    TWCR = (TWCR_W(twcr) & ~cleared) | twea;
+    if (callback != nullptr)
+        callback(s, context);
+}
+
+void MasterAsync::_addressSlave(uint8_t rw)
+{
+    // Set address (SLA+R/W)
+    TWDR = (transaction.address << 1) | rw;
+    // Send SLA+R/W (clears TWSTA)
+    TWCR = TWCR_W(_BV(TWINT));
+}
+
+void MasterAsync::_receiveNext()
+{
+    // Acknowledge every byte except the last one
+    if (transaction.size - count > 1)
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
+    else
+        TWCR = TWCR_W(_BV(TWINT)) & ~_BV(TWEA);
+}
+
+bool MasterAsync::_isIdle()
+{
+    // Bus held by the last transaction, otherwise nothing may be in progress (slave role included)
+    return held || (TW_STATUS == TW_NO_INFO && !(TWCR & _BV(TWINT)));
+}
+
+bool MasterAsync::submit(const Transaction &transaction)
+{
+    bool accepted = true;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (busy || suspended || pending > 0)
+        {
+            accepted = _push(transaction);
+            if (accepted && !busy && !suspended && _isIdle())
+            {
+                // Queue was stalled and the TWI is idle (otherwise the slave role is served, resume starts the queue)
+                _next();
+                _begin();
+            }
+        }
+        else if (_isIdle())
+        {
+            _prepare(transaction);
+            _begin();
+        }
+        else if (capacity > 0)
+        {
+            // Slave role is served, resume starts the queue
+            accepted = _push(transaction);
+        }
+        else
+        {
+            // Without a queue the transaction waits unstarted, resume requests its START
+            _prepare(transaction);
+        }
+    }
+    return accepted;
+}
+
+void MasterAsync::resume()
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (suspended)
+        {
+            // Interrupted transaction goes before the queued ones
+            suspended = false;
+            busy = true;
+            _begin();
+        }
+        else if (busy && !started)
+        {
+            // Slave transaction acknowledged with TWSTA cleared, START has to be requested again
+            _begin();
+        }
+        else if (!busy && pending > 0)
+        {
+            _next();
+            _begin();
+        }
+    }
+}
+
+void MasterAsync::setArbitrationRetries(uint8_t retries)
+{
+    arbitrationRetries = retries;
+}
+
+bool MasterAsync::isSuspended()
+{
+    return suspended;
+}
+
+size_t MasterAsync::getPendingCount()
+{
+    return pending;
+}
+
+bool MasterAsync::send(uint8_t address, const uint8_t *data, size_t size, bool stop, Callback callback, void *context)
+{
+    return submit({Type::Send, address, 0, data, nullptr, size, false, stop, callback, context});
+}
+
+bool MasterAsync::send(uint8_t address, const uint8_t *data, size_t size, bool stop)
+{
+    return send(address, data, size, stop, nullptr, nullptr);
+}
+
+bool MasterAsync::send(uint8_t address, const uint8_t *data, size_t size)
+{
+    return send(address, data, size, true);
+}
+
+bool MasterAsync::receive(uint8_t address, uint8_t *data, size_t size, bool stop, Callback callback, void *context)
+{
+    return submit({Type::Receive, address, 0, nullptr, data, size, false, stop, callback, context});
+}
+
+bool MasterAsync::receive(uint8_t address, uint8_t *data, size_t size, bool stop)
+{
+    return receive(address, data, size, stop, nullptr, nullptr);
+}
+
+bool MasterAsync::receive(uint8_t address, uint8_t *data, size_t size)
+{
+    return receive(address, data, size, true);
+}
+
+bool MasterAsync::receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop, Callback callback, void *context)
+{
+    return submit({Type::ReceiveRegister, address, registerAddress, nullptr, data, size, repeatStart, stop, callback, context});
+}
+
+bool MasterAsync::receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop)
+{
+    return receiveRegister(address, registerAddress, data, size, repeatStart, stop, nullptr, nullptr);
+}
+
+bool MasterAsync::receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart)
+{
+    return receiveRegister(address, registerAddress, data, size, repeatStart, true);
+}
+
+bool MasterAsync::isBusy()
+{
+    return busy;
+}
+
+Status MasterAsync::getStatus()
+{
+    return status;
+}
+
+bool MasterAsync::interruptVectorRoutine()
+{
+    if (!busy)
+        return false;
+    switch (TW_STATUS)
+    {
+    case TW_START:
+    case TW_REP_START:
+        started = true;
+        _addressSlave(transaction.type == Type::Receive || registerSent ? TW_READ : TW_WRITE);
+        break;
+    case TW_MT_SLA_ACK:
+    case TW_MT_DATA_ACK:
+        if (transaction.type == Type::ReceiveRegister)
+        {
+            if (!registerSent)
+            {
+                // Send register address
+                TWDR = transaction.registerAddress;
+                TWCR = TWCR_W(_BV(TWINT));
+                registerSent = true;
+            }
+            else
+            {
+                // Restart or StopStart
+                TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTA) | (transaction.repeatStart ? 0 : _BV(TWSTO)));
+            }
+        }
+        else if (count < transaction.size)
+        {
+            // Send next data
+            TWDR = transaction.sendData[count];
+            TWCR = TWCR_W(_BV(TWINT));
+            count++;
+        }
+        else
+        {
+            // If stop is set, release bus
+            _finish(Status::Success, transaction.stop ? _BV(TWINT) | _BV(TWSTO) : 0);
+        }
+        break;
+    case TW_MR_SLA_ACK:
+        _receiveNext();
+        break;
+    case TW_MR_DATA_ACK:
+        transaction.receiveData[count] = TWDR;
+        count++;
+        _receiveNext();
+        break;
+    case TW_MR_DATA_NACK:
+        if (count < transaction.size)
+        {
+            transaction.receiveData[count] = TWDR;
+            count++;
+        }
+        // If stop is set, release bus
+        _finish(Status::Success, transaction.stop ? _BV(TWINT) | _BV(TWSTO) : 0);
+        break;
+    case TW_MT_SLA_NACK:
+    case TW_MR_SLA_NACK:
+        _finish(Status::AddressNACK, _BV(TWINT) | _BV(TWSTO));
+        break;
+    case TW_MT_DATA_NACK:
+        _finish(Status::DataNACK, _BV(TWINT) | _BV(TWSTO));
+        break;
+    // No need to stop when arbitration lost
+    case TW_MT_ARB_LOST:
+        if (arbitrationLosses < arbitrationRetries)
+        {
+            // START is sent once the bus is free
+            _restart();
+            TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTA));
+            break;
+        }
+        _finish(Status::BusLost, _BV(TWINT));
+        break;
+    case TW_SR_ARB_LOST_SLA_ACK:
+    case TW_SR_ARB_LOST_GCALL_ACK:
+    case TW_ST_ARB_LOST_SLA_ACK:
+        if (arbitrationLosses < arbitrationRetries)
+        {
+            // Wait for resume, slave routine has to handle the status
+            _restart();
+            busy = false;
+            suspended = true;
+            return false;
+        }
+        // Leave TWCR untouched, slave routine has to handle the status
+        status = Status::AddressedAsSlave;
+        busy = false;
+        if (transaction.callback != nullptr)
+            transaction.callback(Status::AddressedAsSlave, transaction.context);
+        return false;
+    case TW_BUS_ERROR:
+        _finish(Status::Error, _BV(TWINT) | _BV(TWSTO));
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "TwoWireMasterConfiguration.hpp"
+
+namespace TwoWire
+{
+    class MasterAsync
+    {
+    public:
+        using Status = MasterConfiguration::Status;
+
+        /**
+         * @brief Function called (from the TWI interrupt) when a transaction finishes
+         *
+         * @param status Status of the finished transaction
+         * @param context User provided context
+         */
+        using Callback = void (*)(Status status, void *context);
+
+        enum class Type : int8_t
+        {
+            // Write data to the slave
+            Send,
+            // Read data from the slave
+            Receive,
+            // Write register address then read data from the slave
+            ReceiveRegister
+        };
+
+        struct Transaction
+        {
+            Type type;
+            uint8_t address;
+            uint8_t registerAddress;
+            const uint8_t *sendData;
+            uint8_t *receiveData;
+            size_t size;
+            bool repeatStart;
+            bool stop;
+            Callback callback;
+            void *context;
+        };
+
+    protected:
+        Transaction transaction;
+        Transaction *queue;
+        size_t capacity;
+        size_t head;
+        volatile size_t pending;
+        size_t count;
+        bool registerSent;
+        uint8_t twea;
+        // Last transaction finished without releasing the bus (TWINT is left set)
+        volatile bool held;
+        volatile bool busy;
+        // START of the current transaction was acknowledged (lost if the slave role cleared TWSTA before)
+        volatile bool started;
+        volatile bool suspended;
+        uint8_t arbitrationRetries;
+        uint8_t arbitrationLosses;
+        volatile Status status;
+
+        void _prepare(const Transaction &transaction);
+
+        void _restart();
+
+        void _begin();
+
+        bool _push(const Transaction &transaction);
+
+        void _next();
+
+        bool _isIdle();
+
+        void _finish(Status s, uint8_t twcr);
+
+        void _addressSlave(uint8_t rw);
+
+        void _receiveNext();
+
+    public:
+        /**
+         * @brief Create asynchronous Master with a transaction queue
+         *  (queued transactions are started back-to-back from the TWI interrupt)
+         *
+         * @param queue Storage for pending transactions
+         * @param capacity Number of transactions the storage can hold
+         */
+        MasterAsync(Transaction *queue, size_t capacity);
+
+        /**
+         * @brief Create asynchronous Master
+         *  (without a queue only one transaction can be submitted at a time)
+         *
+         */
+        MasterAsync();
+
+        /**
+         * @brief Submit a transaction
+         *  (returns immediately, the transaction is executed from the TWI interrupt,
+         *  while the slave role is served it waits for resume)
+         *
+         * @param transaction Transaction to execute
+         * @return true Transaction was accepted
+         * @return false Another transaction is in progress and the queue is full
+         */
+        bool submit(const Transaction &transaction);
+
+        /**
+         * @brief Start the next queued transaction if none is in progress
+         *  (needed after the master was addressed as slave, once the slave transaction is done,
+         *  a transaction suspended by lost arbitration is started first, a transaction whose START
+         *  was dropped by the slave role requests it again)
+         *
+         */
+        void resume();
+
+        /**
+         * @brief Set how many times a transaction is restarted after losing arbitration
+         *  (lost bus is retried with START once the bus is free, when addressed as slave the transaction
+         *  is suspended until resume, once the retries are used up the transaction finishes with BusLost/AddressedAsSlave)
+         *
+         * @param retries Number of restarts per transaction (0 to finish on the first loss)
+         */
+        void setArbitrationRetries(uint8_t retries);
+
+        /**
+         * @brief Check whether a transaction waits for resume after the master was addressed as slave
+         *
+         * @return true Transaction is suspended
+         * @return false No transaction is suspended
+         */
+        bool isSuspended();
+
+        /**
+         * @brief Get number of transactions waiting in the queue
+         *
+         * @return size_t Number of pending transactions
+         */
+        size_t getPendingCount();
+
+        /**
+         * @brief Send data to slave device at address
+         *  (data has to stay valid until the transaction finishes)
+         *
+         * @param address Address of the slave device
+         * @param data Data to send
+         * @param size Size of the data
+         * @param stop Whether to release the bus on completion
+         *  (a held bus keeps the TWI interrupt disabled until the next transaction)
+         * @param callback Function called on completion (can be nullptr)
+         * @param context Context passed to the callback
+         * @return true Transaction was accepted
+         * @return false Another transaction is in progress and the queue is full
+         */
+        bool send(uint8_t address, const uint8_t *data, size_t size, bool stop, Callback callback, void *context);
+        bool send(uint8_t address, const uint8_t *data, size_t size, bool stop);
+        bool send(uint8_t address, const uint8_t *data, size_t size);
+
+        /**
+         * @brief Receive data from slave device at address
+         *  (data is valid only after the transaction finishes)
+         *
+         * @param address Address of the slave device
+         * @param data Where to receive the data
+         * @param size Size of the data
+         * @param stop Whether to release the bus on completion
+         *  (a held bus keeps the TWI interrupt disabled until the next transaction)
+         * @param callback Function called on completion (can be nullptr)
+         * @param context Context passed to the callback
+         * @return true Transaction was accepted
+         * @return false Another transaction is in progress and the queue is full
+         */
+        bool receive(uint8_t address, uint8_t *data, size_t size, bool stop, Callback callback, void *context);
+        bool receive(uint8_t address, uint8_t *data, size_t size, bool stop);
+        bool receive(uint8_t address, uint8_t *data, size_t size);
+
+        /**
+         * @brief Receive slave device register contents
+         *
+         * @param address Address of the slave device
+         * @param registerAddress Address of the slave device register
+         * @param data Where to receive the data
+         * @param size Size of the data
+         * @param repeatStart Does the device support repeat start (or should stop start be used)
+         * @param stop Whether to release the bus on completion
+         *  (a held bus keeps the TWI interrupt disabled until the next transaction)
+         * @param callback Function called on completion (can be nullptr)
+         * @param context Context passed to the callback
+         * @return true Transaction was accepted
+         * @return false Another transaction is in progress and the queue is full
+         */
+        bool receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop, Callback callback, void *context);
+        bool receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart, bool stop);
+        bool receiveRegister(uint8_t address, uint8_t registerAddress, uint8_t *data, size_t size, bool repeatStart);
+
+        /**
+         * @brief Check whether a transaction is in progress
+         *
+         * @return true Transaction is in progress
+         * @return false TWI is idle
+         */
+        bool isBusy();
+
+        /**
+         * @brief Get status of the last finished transaction
+         *
+         * @return Status Status of the last transaction
+         */
+        Status getStatus();
+
+        /**
+         * @brief Function to be called in TWI Interrupt Service Routine
+         *
+         * @return true Interrupt was handled by the master
+         * @return false Interrupt was not meant for the master (pass it to the slave routines)
+         */
+        bool interruptVectorRoutine();
+    };
+}
@@ -1,277 +1,115 @@
 #include "TwoWireMasterConfiguration.hpp"
 
-#include <compat/twi.h>
-
 using namespace TwoWire;
 
 using Status = MasterConfiguration::Status;
 
 MasterConfiguration::MasterConfiguration(uint32_t timeout)
-    : timeout(timeout)
+    : RuntimeTimeout(timeout)
 {
 }
 
 MasterConfiguration::MasterConfiguration()
-    : MasterConfiguration((uint32_t)(-1))
+    : RuntimeTimeout()
 {
 }
 
-void MasterConfiguration::setTimeout(uint32_t timeout)
+Status MasterConfiguration::signalStart()
 {
-    this->timeout = timeout;
+    RETURN_EXECUTE_TIMED_FUNCTION_NOARGS(_signalStart<Instrumentation>);
 }
 
-void MasterConfiguration::disableTimeout()
+Status MasterConfiguration::signalStart(Deadline &deadline)
 {
-    this->timeout = (uint32_t)(-1);
+    return _signalStart<Instrumentation>(deadline);
 }
 
-bool MasterConfiguration::_awaitTWINT(uint32_t t)
+Status MasterConfiguration::signalStopStart()
 {
-    while (!(TWCR & _BV(TWINT)) && (uint32_t)micros() - t <= timeout)
-    {
-    }
-    return micros() - t > timeout;
+    RETURN_EXECUTE_TIMED_FUNCTION_NOARGS(_signalStopStart<Instrumentation>);
 }
 
-Status MasterConfiguration::_signalStart(uint32_t t)
+Status MasterConfiguration::signalStopStart(Deadline &deadline)
 {
-    // Send START condition
-    TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTA));
-    // Wait for TWINT or timeout
-    if (_awaitTWINT(t))
-        return Status::Timeout;
-    // Check status
-    switch (TW_STATUS)
-    {
-    case TW_START:
-    case TW_REP_START:
-        return Status::Success;
-    case TW_BUS_ERROR:
-        TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTO));
-        return Status::Error;
-    default:
-        return Status::Unknown;
-    }
+    return _signalStopStart<Instrumentation>(deadline);
 }
 
-Status MasterConfiguration::_signalStopStart(uint32_t t)
+Status MasterConfiguration::addressForWriting(uint8_t address)
 {
-    // Send STOP|START condition
-    TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTO) | _BV(TWSTA));
-    // Wait for TWINT or timeout
-    if (_awaitTWINT(t))
-        return Status::Timeout;
-    // Check status
-    switch (TW_STATUS)
-    {
-    case TW_START:
-    case TW_REP_START:
-        return Status::Success;
-    case TW_BUS_ERROR:
-        TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTO));
-        return Status::Error;
-    default:
-        return Status::Unknown;
-    }
+    RETURN_EXECUTE_TIMED_FUNCTION(_addressSlaveW<Instrumentation>, address);
 }
 
-Status MasterConfiguration::_addressSlaveW(uint32_t t, uint8_t address)
+Status MasterConfiguration::addressForWriting(uint8_t address, Deadline &deadline)
 {
-    // Set address (SLA+W)
-    TWDR = (address << 1) | TW_WRITE;
-    // Send SLA+W
-    TWCR = TWCR_W(_BV(TWINT));
-    // Wait for TWINT or timeout
-    if (_awaitTWINT(t))
-        return Status::Timeout;
-    // Check status
-    switch (TW_STATUS)
-    {
-    case TW_MT_SLA_ACK:
-        return Status::Success;
-    case TW_MT_SLA_NACK:
-        return Status::AddressNACK;
-    // No need to stop when arbitration lost
-    case TW_MT_ARB_LOST:
-        return Status::BusLost;
-    case TW_SR_ARB_LOST_SLA_ACK:
-    case TW_SR_ARB_LOST_GCALL_ACK:
-    case TW_ST_ARB_LOST_SLA_ACK:
-        return Status::AddressedAsSlave;
-    case TW_BUS_ERROR:
-        TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTO));
-        return Status::Error;
-    default:
-        return Status::Unknown;
-    }
+    return _addressSlaveW<Instrumentation>(deadline, address);
 }
 
-Status MasterConfiguration::_sendData(uint32_t t, uint8_t data)
+Status MasterConfiguration::addressForReading(uint8_t address)
 {
-    // Set data
-    TWDR = data;
-    // Send data
-    TWCR = TWCR_W(_BV(TWINT));
-    // Wait for TWINT or timeout
-    if (_awaitTWINT(t))
-        return Status::Timeout;
-    // Check status
-    switch (TW_STATUS)
-    {
-    case TW_MT_DATA_ACK:
-        return Status::Success;
-    case TW_MT_DATA_NACK:
-        return Status::DataNACK;
-    case TW_MT_ARB_LOST:
-        // No need to stop when arbitration lost
-        return Status::BusLost;
-    case TW_BUS_ERROR:
-        TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTO));
-        return Status::Error;
-    default:
-        return Status::Unknown;
-    }
+    RETURN_EXECUTE_TIMED_FUNCTION(_addressSlaveR<Instrumentation>, address);
 }
 
-Status MasterConfiguration::_sendData(uint32_t t, const uint8_t *data, size_t size)
+Status MasterConfiguration::addressForReading(uint8_t address, Deadline &deadline)
 {
-    while (size > 0)
-    {
-        auto s = _sendData(t, *data);
-        if (s != Status::Success)
-            return s;
-        data++;
-        size--;
-    }
-    return Status::Success;
+    return _addressSlaveR<Instrumentation>(deadline, address);
 }
 
-Status MasterConfiguration::_addressSlaveR(uint32_t t, uint8_t address)
+Status MasterConfiguration::sendData(uint8_t data)
 {
-    // Set address (SLA+R)
-    TWDR = (address << 1) | TW_READ;
-    // Send SLA+R
-    TWCR = TWCR_W(_BV(TWINT));
-    // Wait for TWINT or timeout
-    if (_awaitTWINT(t))
-        return Status::Timeout;
-    // Check status
-    switch (TW_STATUS)
-    {
-    case TW_MR_SLA_ACK:
-        return Status::Success;
-    case TW_MR_SLA_NACK:
-        return Status::AddressNACK;
-    // No need to stop when arbitration lost
-    case TW_MR_ARB_LOST:
-        return Status::BusLost;
-    case TW_SR_ARB_LOST_SLA_ACK:
-    case TW_SR_ARB_LOST_GCALL_ACK:
-    case TW_ST_ARB_LOST_SLA_ACK:
-        return Status::AddressedAsSlave;
-    case TW_BUS_ERROR:
-        TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTO));
-        return Status::Error;
-    default:
-        return Status::Unknown;
-    }
+    RETURN_EXECUTE_TIMED_FUNCTION(_sendData<Instrumentation>, data);
 }
 
-// TODO: Save TWEA before using it (so it isnt changed after the function)
-Status MasterConfiguration::_receiveData(uint32_t t, uint8_t *data)
+Status MasterConfiguration::sendData(uint8_t data, Deadline &deadline)
 {
-    // Set to read only 1 byte
-    TWCR &= ~(_BV(TWEA));
-    // Read data
-    TWCR = TWCR_W(_BV(TWINT));
-    // Wait for TWINT or timeout
-    if (_awaitTWINT(t))
-        return Status::Timeout;
-    // Check status
-    switch (TW_STATUS)
-    {
-    case TW_MR_DATA_NACK:
-        *data = TWDR;
-        return Status::Success;
-    case TW_MR_ARB_LOST:
-        // No need to stop when arbitration lost
-        return Status::BusLost;
-    case TW_BUS_ERROR:
-        TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTO));
-        return Status::Error;
-    default:
-        return Status::Unknown;
-    }
+    return _sendData<Instrumentation>(deadline, data);
 }
 
-// TODO: Save TWEA before using it (so it isnt changed after the function)
-Status MasterConfiguration::_receiveData(uint32_t t, uint8_t *data, size_t size)
+Status MasterConfiguration::sendData(const uint8_t *data, size_t size)
 {
-    while (size > 1)
-    {
-        // Set to read more than 1 byte
-        TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
-        // Wait for TWINT or timeout
-        if (_awaitTWINT(t))
-            return Status::Timeout;
-        // Check status
-        switch (TW_STATUS)
-        {
-        case TW_MR_DATA_ACK:
-            break;
-        case TW_MR_ARB_LOST:
-            // No need to stop when arbitration lost
-            return Status::BusLost;
-        case TW_BUS_ERROR:
-            TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTO));
-            return Status::Error;
-        default:
-            return Status::Unknown;
-        }
-        *data = TWDR;
-        data++;
-        size--;
-    }
-    return _receiveData(t, data);
+    RETURN_EXECUTE_TIMED_FUNCTION(_sendData<Instrumentation>, data, size);
 }
 
-Status MasterConfiguration::signalStart()
+Status MasterConfiguration::sendData(const uint8_t *data, size_t size, Deadline &deadline)
 {
-    RETURN_EXECUTE_TIMED_FUNCTION_NOARGS(_signalStart);
+    return _sendData<Instrumentation>(deadline, data, size);
 }
 
-Status MasterConfiguration::signalStopStart()
+Status MasterConfiguration::sendData(const SendSegment *segments, size_t count)
 {
-    RETURN_EXECUTE_TIMED_FUNCTION_NOARGS(_signalStopStart);
+    RETURN_EXECUTE_TIMED_FUNCTION(_sendData<Instrumentation>, segments, count);
 }
 
-Status MasterConfiguration::addressForWriting(uint8_t address)
+Status MasterConfiguration::sendData(const SendSegment *segments, size_t count, Deadline &deadline)
 {
-    RETURN_EXECUTE_TIMED_FUNCTION(_addressSlaveW, address);
+    return _sendData<Instrumentation>(deadline, segments, count);
 }
 
-Status MasterConfiguration::addressForReading(uint8_t address)
+Status MasterConfiguration::receiveData(uint8_t *data)
 {
-    RETURN_EXECUTE_TIMED_FUNCTION(_addressSlaveR, address);
+    RETURN_EXECUTE_TIMED_FUNCTION(_receiveData<Instrumentation>, data);
 }
 
-Status MasterConfiguration::sendData(uint8_t data)
+Status MasterConfiguration::receiveData(uint8_t *data, Deadline &deadline)
 {
-    RETURN_EXECUTE_TIMED_FUNCTION(_sendData, data);
+    return _receiveData<Instrumentation>(deadline, data);
 }
 
-Status MasterConfiguration::sendData(const uint8_t *data, size_t size)
+Status MasterConfiguration::receiveData(uint8_t *data, size_t size)
 {
-    RETURN_EXECUTE_TIMED_FUNCTION(_sendData, data, size);
+    RETURN_EXECUTE_TIMED_FUNCTION(_receiveData<Instrumentation>, data, size);
 }
 
-Status MasterConfiguration::receiveData(uint8_t *data)
+Status MasterConfiguration::receiveData(uint8_t *data, size_t size, Deadline &deadline)
 {
-    RETURN_EXECUTE_TIMED_FUNCTION(_receiveData, data);
+    return _receiveData<Instrumentation>(deadline, data, size);
 }
 
-Status MasterConfiguration::receiveData(uint8_t *data, size_t size)
+Status MasterConfiguration::receiveData(const ReceiveSegment *segments, size_t count)
+{
+    RETURN_EXECUTE_TIMED_FUNCTION(_receiveData<Instrumentation>, segments, count);
+}
+
+Status MasterConfiguration::receiveData(const ReceiveSegment *segments, size_t count, Deadline &deadline)
 {
-    RETURN_EXECUTE_TIMED_FUNCTION(_receiveData, data, size);
+    return _receiveData<Instrumentation>(deadline, segments, count);
 }
@@ -1,64 +1,24 @@
 #pragma once
 
-#include "TwoWireCore.hpp"
-#include <Arduino.h>
+#include "TwoWireMasterPrimitives.hpp"
+#include "TwoWireMasterPolicy.hpp"
+#include "TwoWireMasterInstrumentation.hpp"
 
 #define RETURN_EXECUTE_TIMED_FUNCTION(function, ...) \
-    uint32_t t = micros(); \
-    return function(t, ##__VA_ARGS__)
+    Deadline d = _deadline(); \
+    return function(d, ##__VA_ARGS__)
 
 #define RETURN_EXECUTE_TIMED_FUNCTION_NOARGS(function) \
-    uint32_t t = micros(); \
-    return function(t)
+    Deadline d = _deadline(); \
+    return function(d)
 
 namespace TwoWire
 {
-    class MasterConfiguration
+    class MasterConfiguration : public MasterPrimitives, public MasterPolicy::RuntimeTimeout
     {
     protected:
-        static constexpr auto DEFAULT_TIMEOUT = 25000;
-
-    public:
-        enum class Status : int8_t
-        {
-            // Successful operation
-            Success,
-            // Unable to locate slave device of provided address
-            AddressNACK,
-            // Slave is unable to accept given data (only possible when writing)
-            DataNACK,
-            // Lost the I2C bus to another master device
-            BusLost,
-            // Lost the I2C bus to another master device who addressed us (check slave status for more information)
-            AddressedAsSlave,
-            // Provided timeout expired during operation
-            Timeout,
-            // Error raised when calling start or stop unexpectedly
-            Error,
-            // Error was unexpected and its cause is unknown
-            Unknown
-        };
-
-    protected:
-        uint32_t timeout;
-
-        bool _awaitTWINT(uint32_t t);
-
-        Status _signalStart(uint32_t t);
-
-        Status _signalStopStart(uint32_t t);
-
-        Status _addressSlaveW(uint32_t t, uint8_t address);
-
-        Status _sendData(uint32_t t, uint8_t data);
-
-        Status _sendData(uint32_t t, const uint8_t *data, size_t size);
-
-        Status _addressSlaveR(uint32_t t, uint8_t address);
-
-        Status _receiveData(uint32_t t, uint8_t *data);
-
-        Status _receiveData(uint32_t t, uint8_t *data, size_t size);
+        // Statuses and bytes of the commands are reported to the trace and statistics
+        using Instrumentation = MasterPolicy::StatisticsInstrumentation;
 
     public:
         /**
@@ -74,66 +34,90 @@ namespace TwoWire
          */
         MasterConfiguration();
 
-        /**
-         * @brief Set the timeout for I2C operations
-         *
-         * @param timeout Timeout in microseconds
-         */
-        void setTimeout(uint32_t timeout = DEFAULT_TIMEOUT);
-
-        /**
-         * @brief Disables timeout for I2C operations
-         *  (in other words it sets timeout to be infinity)
-         * 
-         */
-        void disableTimeout();
-
         /**
          * @brief Signal start to slave devices
          *
+         * @param deadline Deadline shared by a sequence of commands (optional, timeout is used otherwise)
          * @return Status Command status
          */
         Status signalStart();
+        Status signalStart(Deadline &deadline);
 
         /**
          * @brief Signal stop then start (in a single operation)
          *
+         * @param deadline Deadline shared by a sequence of commands (optional, timeout is used otherwise)
          * @return Status Command status
          */
         Status signalStopStart();
+        Status signalStopStart(Deadline &deadline);
 
         /**
          * @brief Address slave for writing
          *
          * @param address Address of the slave device
+         * @param deadline Deadline shared by a sequence of commands (optional, timeout is used otherwise)
          * @return Status Command status
          */
         Status addressForWriting(uint8_t address);
+        Status addressForWriting(uint8_t address, Deadline &deadline);
 
         /**
          * @brief Address slave for reading
          *
          * @param address Address of the slave device
+         * @param deadline Deadline shared by a sequence of commands (optional, timeout is used otherwise)
          * @return Status Command status
          */
         Status addressForReading(uint8_t address);
+        Status addressForReading(uint8_t address, Deadline &deadline);
 
         /**
          * @brief Write data to the bus
          *
          * @param data Data to write
+         * @param deadline Deadline shared by a sequence of commands (optional, timeout is used otherwise)
          * @return Status Command status
          */
         Status sendData(uint8_t data);
         Status sendData(const uint8_t *data, size_t size);
+        Status sendData(uint8_t data, Deadline &deadline);
+        Status sendData(const uint8_t *data, size_t size, Deadline &deadline);
+
+        /**
+         * @brief Write data of multiple segments to the bus
+         *  (segments are sent back to back as if they were one buffer)
+         *
+         * @param segments Segments to write
+         * @param count Number of segments
+         * @param deadline Deadline shared by a sequence of commands (optional, timeout is used otherwise)
+         * @return Status Command status
+         */
+        Status sendData(const SendSegment *segments, size_t count);
+        Status sendData(const SendSegment *segments, size_t count, Deadline &deadline);
 
         /**
          * @brief Read data from the bus
          *
          * @param data Where to store data
+         * @param deadline Deadline shared by a sequence of commands (optional, timeout is used otherwise)
          * @return Status Command status
          */
         Status receiveData(uint8_t *data);
         Status receiveData(uint8_t *data, size_t size);
+        Status receiveData(uint8_t *data, Deadline &deadline);
+        Status receiveData(uint8_t *data, size_t size, Deadline &deadline);
+
+        /**
+         * @brief Read data from the bus into multiple segments
+         *  (only the last byte of the last non-empty segment is not acknowledged)
+         *
+         * @param segments Segments to fill
+         * @param count Number of segments
+         * @param deadline Deadline shared by a sequence of commands (optional, timeout is used otherwise)
+         * @return Status Command status
+         */
+        Status receiveData(const ReceiveSegment *segments, size_t count);
+        Status receiveData(const ReceiveSegment *segments, size_t count, Deadline &deadline);
     };
 }
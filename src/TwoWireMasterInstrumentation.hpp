@@ -0,0 +1,51 @@
+#pragma once
+
+#include "TwoWireMasterPrimitives.hpp"
+#include "TwoWireStatistics.hpp"
+#include "TwoWireTrace.hpp"
+
+namespace TwoWire
+{
+    namespace MasterPolicy
+    {
+        /**
+         * @brief Operations are reported to the statistics, statuses of their commands to the trace
+         *  (compiles to nothing unless TWOWIRE_STATISTICS or TWOWIRE_TRACE is defined)
+         *
+         */
+        class StatisticsInstrumentation
+        {
+        public:
+            static void _record(uint8_t status)
+            {
+                Trace::_record(status);
+            }
+
+            static void _recordTimeout()
+            {
+                Trace::_record(Trace::TIMEOUT);
+            }
+
+            static void _recordStop()
+            {
+                Trace::_record(Trace::STOP);
+            }
+
+            static void _countByte()
+            {
+                Statistics::_countByte();
+            }
+
+        protected:
+            static void _beginTransaction()
+            {
+                Statistics::_beginTransaction();
+            }
+
+            static void _endTransaction(Statistics::Transaction type, uint8_t address, MasterPrimitives::Status status, uint8_t attempts)
+            {
+                Statistics::_endTransaction(type, address, status, attempts);
+            }
+        };
+    }
+}
@@ -0,0 +1,107 @@
+#include "TwoWireMasterPolicy.hpp"
+
+#include "TwoWireBusRecovery.hpp"
+#include "TwoWireSlaveDispatcher.hpp"
+
+#include <Arduino.h>
+
+using namespace TwoWire;
+using namespace TwoWire::MasterPolicy;
+
+using Status = MasterPrimitives::Status;
+
+RuntimeTimeout::RuntimeTimeout(uint32_t timeout)
+    : timeout(timeout)
+{
+}
+
+RuntimeTimeout::RuntimeTimeout()
+    : RuntimeTimeout(TIMEOUT_DISABLED)
+{
+}
+
+void RuntimeTimeout::setTimeout(uint32_t timeout)
+{
+    this->timeout = timeout;
+}
+
+void RuntimeTimeout::disableTimeout()
+{
+    this->timeout = TIMEOUT_DISABLED;
+}
+
+RuntimeBusLost::RuntimeBusLost(BusLostBehaviour behaviour)
+    : busLostBehaviour(behaviour)
+{
+}
+
+RuntimeBusLost::RuntimeBusLost()
+    : RuntimeBusLost(BusLostBehaviour::Abort)
+{
+}
+
+void RuntimeBusLost::setBusLostBehaviour(BusLostBehaviour behaviour)
+{
+    this->busLostBehaviour = behaviour;
+}
+
+RuntimeRetry::RuntimeRetry()
+    : retryPolicy{0, retryOn(Status::BusLost), Backoff::None, 0}, attempts(0), slaveRoutine(nullptr), slaveObject(nullptr), recovery(nullptr)
+{
+}
+
+void RuntimeRetry::setRetryPolicy(const RetryPolicy &policy)
+{
+    this->retryPolicy = policy;
+}
+
+uint8_t RuntimeRetry::getAttempts()
+{
+    return attempts;
+}
+
+void RuntimeRetry::setSlaveHandler(const SlaveHandler &handler)
+{
+    this->slaveRoutine = handler.routine;
+    this->slaveObject = handler.object;
+}
+
+void RuntimeRetry::setBusRecovery(BusRecovery *recovery)
+{
+    this->recovery = recovery;
+}
+
+void RuntimeRetry::_recoverBus()
+{
+    // Bus is stuck only if some device holds a line
+    if (recovery != nullptr && !BusRecovery::isBusIdle())
+        recovery->recover();
+}
+
+void RuntimeRetry::_backoff(uint32_t limit, uint8_t attempts)
+{
+    uint32_t delay = retryPolicy.backoffDelay;
+    switch (retryPolicy.backoff)
+    {
+    case Backoff::None:
+        return;
+    case Backoff::Fixed:
+        break;
+    case Backoff::Exponential:
+    case Backoff::Randomized:
+        delay <<= attempts - 1 < 8 ? attempts - 1 : 8;
+        if (retryPolicy.backoff == Backoff::Randomized)
+            delay = random(delay + 1);
+        break;
+    }
+    // Backoff can't outlast the deadline
+    if (delay > limit)
+        delay = limit;
+    // delayMicroseconds is only accurate up to 16383 us
+    while (delay > 16383)
+    {
+        delayMicroseconds(16383);
+        delay -= 16383;
+    }
+    delayMicroseconds(delay);
+}
@@ -0,0 +1,368 @@
+#pragma once
+
+#include "TwoWireMasterPrimitives.hpp"
+#include "TwoWireDeadline.hpp"
+#include "TwoWireTransaction.hpp"
+
+namespace TwoWire
+{
+    class BusRecovery;
+    struct SlaveHandler;
+
+    // Policies of BasicMaster, each is resolved at compile time and the "No" policies generate no code
+    namespace MasterPolicy
+    {
+        enum class BusLostBehaviour : int8_t
+        {
+            // Terminate instruction
+            Abort,
+            // Wait until the bus is free
+            RetryWithinTimeout,
+            RetryExtendingTimeout
+        };
+
+        // -- Timeout policies (deadline of operations not given one by the caller) --
+
+        /**
+         * @brief Operations never time out
+         *  (only TWINT is polled, micros() is never called)
+         *
+         */
+        class NoTimeout
+        {
+        protected:
+            NoDeadline _deadline() const
+            {
+                return NoDeadline{};
+            }
+        };
+
+        /**
+         * @brief Timeout fixed at compile time
+         *
+         * @tparam timeout Timeout in microseconds
+         */
+        template <uint32_t timeout>
+        class FixedTimeout
+        {
+        protected:
+            Deadline _deadline() const
+            {
+                return Deadline{timeout};
+            }
+        };
+
+        /**
+         * @brief Timeout set at runtime
+         *
+         */
+        class RuntimeTimeout
+        {
+        protected:
+            static constexpr auto DEFAULT_TIMEOUT = 25000;
+            static constexpr uint32_t TIMEOUT_DISABLED = Deadline::UNLIMITED;
+
+            uint32_t timeout;
+
+            Deadline _deadline() const
+            {
+                return Deadline{timeout};
+            }
+
+        public:
+            /**
+             * @brief Create runtime timeout
+             *
+             * @param timeout Timeout in microseconds
+             */
+            RuntimeTimeout(uint32_t timeout);
+
+            /**
+             * @brief Create runtime timeout
+             *  (timeout is disabled)
+             *
+             */
+            RuntimeTimeout();
+
+            /**
+             * @brief Set the timeout for I2C operations
+             *
+             * @param timeout Timeout in microseconds
+             */
+            void setTimeout(uint32_t timeout = DEFAULT_TIMEOUT);
+
+            /**
+             * @brief Disables timeout for I2C operations
+             *  (in other words it sets timeout to be infinity)
+             *
+             */
+            void disableTimeout();
+        };
+
+        // -- Bus lost policies (only used when the error policy retries) --
+
+        /**
+         * @brief Bus lost behaviour fixed at compile time
+         *
+         * @tparam behaviour Behaviour when the bus is lost to another master
+         */
+        template <BusLostBehaviour behaviour>
+        class FixedBusLost
+        {
+        public:
+            using BusLostBehaviour = MasterPolicy::BusLostBehaviour;
+
+        protected:
+            static constexpr BusLostBehaviour _getBusLostBehaviour()
+            {
+                return behaviour;
+            }
+        };
+
+        /**
+         * @brief Bus lost behaviour set at runtime
+         *
+         */
+        class RuntimeBusLost
+        {
+        public:
+            using BusLostBehaviour = MasterPolicy::BusLostBehaviour;
+
+        protected:
+            BusLostBehaviour busLostBehaviour;
+
+            BusLostBehaviour _getBusLostBehaviour() const
+            {
+                return busLostBehaviour;
+            }
+
+        public:
+            /**
+             * @brief Create runtime bus lost behaviour
+             *
+             * @param behaviour Behaviour when the bus is lost to another master
+             */
+            RuntimeBusLost(BusLostBehaviour behaviour);
+
+            /**
+             * @brief Create runtime bus lost behaviour
+             *  (operations are aborted)
+             *
+             */
+            RuntimeBusLost();
+
+            /**
+             * @brief Set the behaviour of the TWI when bus is lost to another master
+             *
+             * @param behaviour Behaviour to set
+             */
+            void setBusLostBehaviour(BusLostBehaviour behaviour);
+        };
+
+        // -- Error policies (what happens after a failed attempt besides releasing the bus) --
+
+        /**
+         * @brief Failed operations return at once
+         *  (no retry, backoff, bus recovery or serving of the slave role)
+         *
+         */
+        class NoRetry
+        {
+        protected:
+            static constexpr bool _retriesOn(MasterPrimitives::Status)
+            {
+                return false;
+            }
+
+            static constexpr bool _hasAttemptsLeft(uint8_t)
+            {
+                return false;
+            }
+
+            static constexpr bool _hasAttemptLimit()
+            {
+                return false;
+            }
+
+            static constexpr bool _hasSlaveHandler()
+            {
+                return false;
+            }
+
+            static void _callSlaveHandler()
+            {
+            }
+
+            static void _recoverBus()
+            {
+            }
+
+            static void _backoff(uint32_t, uint8_t)
+            {
+            }
+
+            static void _setAttempts(uint8_t)
+            {
+            }
+        };
+
+        /**
+         * @brief Retry policy, slave handler and bus recovery set at runtime
+         *
+         */
+        class RuntimeRetry
+        {
+        public:
+            enum class Backoff : int8_t
+            {
+                // Retry immediately
+                None,
+                // Wait backoffDelay between attempts
+                Fixed,
+                // Double the delay after every attempt
+                Exponential,
+                // Random delay up to the exponential delay
+                Randomized
+            };
+
+            struct RetryPolicy
+            {
+                // Maximum number of attempts (0 for no limit other than the timeout, Timeout is then never retried)
+                uint8_t maxAttempts;
+                // Statuses on which to retry (combination of retryOn(status))
+                uint8_t retryOn;
+                // Delay between attempts
+                Backoff backoff;
+                // Base delay between attempts in microseconds
+                uint16_t backoffDelay;
+            };
+
+            /**
+             * @brief Get retry mask of the status (combine with | for RetryPolicy::retryOn)
+             *
+             * @param status Status to retry on
+             * @return uint8_t Retry mask of the status
+             */
+            static constexpr uint8_t retryOn(MasterPrimitives::Status status)
+            {
+                return 1 << (uint8_t)status;
+            }
+
+        protected:
+            RetryPolicy retryPolicy;
+            uint8_t attempts;
+            void (*slaveRoutine)(void *object);
+            void *slaveObject;
+            BusRecovery *recovery;
+
+            bool _retriesOn(MasterPrimitives::Status s) const
+            {
+                return (retryPolicy.retryOn & retryOn(s)) != 0;
+            }
+
+            bool _hasAttemptsLeft(uint8_t attempts) const
+            {
+                return retryPolicy.maxAttempts == 0 || attempts < retryPolicy.maxAttempts;
+            }
+
+            bool _hasAttemptLimit() const
+            {
+                return retryPolicy.maxAttempts != 0;
+            }
+
+            bool _hasSlaveHandler() const
+            {
+                return slaveRoutine != nullptr;
+            }
+
+            void _callSlaveHandler()
+            {
+                slaveRoutine(slaveObject);
+            }
+
+            void _recoverBus();
+
+            void _backoff(uint32_t limit, uint8_t attempts);
+
+            void _setAttempts(uint8_t attempts)
+            {
+                this->attempts = attempts;
+            }
+
+        public:
+            /**
+             * @brief Create runtime retry
+             *  (bus lost is retried, nothing else)
+             *
+             */
+            RuntimeRetry();
+
+            /**
+             * @brief Set the policy by which failed operations are retried
+             *  (bus lost is retried only if bus lost behaviour allows it)
+             *
+             * @param policy Policy to set
+             */
+            void setRetryPolicy(const RetryPolicy &policy);
+
+            /**
+             * @brief Get number of attempts used by the last operation
+             *
+             * @return uint8_t Number of attempts
+             */
+            uint8_t getAttempts();
+
+            /**
+             * @brief Set handler serving the slave role when the master is addressed after losing arbitration
+             *  (the slave transaction is served by polling, then the operation is restarted within the attempt limit and deadline)
+             *
+             * @param handler Slave handler (SlaveDispatcher::handler(receiver), ..., SlaveDispatcher::none() to report AddressedAsSlave)
+             */
+            void setSlaveHandler(const SlaveHandler &handler);
+
+            /**
+             * @brief Set recovery freeing the bus held by a slave after Timeout or Error
+             *  (recovery runs only if SCL or SDA is held low, the operation is then retried according to the retry policy)
+             *
+             * @param recovery Bus recovery (nullptr to disable)
+             */
+            void setBusRecovery(BusRecovery *recovery);
+        };
+
+        // -- Instrumentation policies (StatisticsInstrumentation is in TwoWireMasterInstrumentation.hpp) --
+
+        /**
+         * @brief Operations are not reported
+         *  (neither transactions nor the statuses and bytes of their commands)
+         *
+         */
+        class NoInstrumentation
+        {
+        public:
+            static void _record(uint8_t)
+            {
+            }
+
+            static void _recordTimeout()
+            {
+            }
+
+            static void _recordStop()
+            {
+            }
+
+            static void _countByte()
+            {
+            }
+
+        protected:
+            static void _beginTransaction()
+            {
+            }
+
+            static void _endTransaction(Statistics::Transaction, uint8_t, MasterPrimitives::Status, uint8_t)
+            {
+            }
+        };
+    }
+}
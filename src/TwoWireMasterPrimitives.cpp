@@ -0,0 +1,18 @@
+#include "TwoWireMasterPrimitives.hpp"
+
+#include "TwoWireStatusTable.hpp"
+
+using namespace TwoWire;
+
+using Status = MasterPrimitives::Status;
+
+Status MasterPrimitives::_getStatus(uint8_t status, uint8_t expected, uint8_t alternative)
+{
+    if (status == expected || status == alternative)
+        return Status::Success;
+    // Bus error has to be cleared with STOP
+    StatusTable::applyAction(status);
+    // Success of another operation is unexpected
+    auto s = StatusTable::getMasterStatus(status);
+    return s == Status::Success ? Status::Unknown : s;
+}
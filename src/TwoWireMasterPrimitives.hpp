@@ -0,0 +1,365 @@
+#pragma once
+
+#include "TwoWireCore.hpp"
+#include "TwoWireDeadline.hpp"
+#include <Arduino.h>
+
+namespace TwoWire
+{
+    /**
+     * @brief Single bus commands shared by the master classes
+     *  (commands are templates of the instrumentation policy and the deadline type, with NoInstrumentation
+     *  the per-byte trace and statistics hooks and with NoDeadline the timeout checks compile to nothing)
+     *
+     */
+    class MasterPrimitives
+    {
+    public:
+        enum class Status : int8_t
+        {
+            // Successful operation
+            Success,
+            // Unable to locate slave device of provided address
+            AddressNACK,
+            // Slave is unable to accept given data (only possible when writing)
+            DataNACK,
+            // Lost the I2C bus to another master device
+            BusLost,
+            // Lost the I2C bus to another master device who addressed us (check slave status for more information)
+            AddressedAsSlave,
+            // Provided timeout expired during operation
+            Timeout,
+            // Error raised when calling start or stop unexpectedly
+            Error,
+            // Error was unexpected and its cause is unknown
+            Unknown
+        };
+
+        struct SendSegment
+        {
+            // Data to send
+            const uint8_t *data;
+            // Size of the data
+            size_t size;
+        };
+
+        struct ReceiveSegment
+        {
+            // Where to receive the data
+            uint8_t *data;
+            // Size of the data
+            size_t size;
+        };
+
+        enum class ByteOrder : int8_t
+        {
+            // Most significant byte of the register address first
+            BigEndian,
+            // Least significant byte of the register address first
+            LittleEndian
+        };
+
+        /**
+         * @brief Register address encoded for the bus
+         *
+         * @tparam size Size of the register address in bytes (1, 2 or 4)
+         * @tparam order Byte order of the register address
+         */
+        template <uint8_t size, ByteOrder order>
+        struct RegisterAddress
+        {
+            static_assert(size == 1 || size == 2 || size == 4, "TwoWire register address has to be 1, 2 or 4 bytes long");
+
+            uint8_t bytes[size];
+
+            RegisterAddress(uint32_t registerAddress)
+            {
+                // Unrolled by the compiler (size and order are known)
+                for (uint8_t i = 0; i < size; i++)
+                    bytes[order == ByteOrder::BigEndian ? size - 1 - i : i] = (uint8_t)(registerAddress >> (8 * i));
+            }
+        };
+
+    protected:
+        // TWINT polls between timeout checks (about 16 us of polling, a poll takes about 8 cycles)
+        static constexpr uint16_t TIMEOUT_CHECK_POLLS = F_CPU / 500000 > 0 ? F_CPU / 500000 : 1;
+
+        // Outcome of the command (unexpected status is acted upon)
+        static Status _getStatus(uint8_t status, uint8_t expected, uint8_t alternative);
+
+        template <class I>
+        static Status _checkStatus(uint8_t expected, uint8_t alternative);
+
+        template <class I>
+        static Status _checkStatus(uint8_t expected);
+
+        // Status check of a transferred data byte (counted by the instrumentation)
+        template <class I>
+        static Status _checkDataStatus(uint8_t expected);
+
+        template <class I, class D>
+        static bool _awaitTWINT(D &d);
+
+        template <class I, class D>
+        static Status _signalStart(D &d);
+
+        template <class I, class D>
+        static Status _signalStopStart(D &d);
+
+        template <class I>
+        static void _signalStop();
+
+        template <class I, class D>
+        static Status _addressSlaveW(D &d, uint8_t address);
+
+        template <class I, class D>
+        static Status _sendData(D &d, uint8_t data);
+
+        template <class I, class D>
+        static Status _sendData(D &d, const uint8_t *data, size_t size);
+
+        template <class I, class D>
+        static Status _sendData(D &d, const SendSegment *segments, size_t count);
+
+        template <class I, class D>
+        static Status _addressSlaveR(D &d, uint8_t address);
+
+        template <class I, class D>
+        static Status _receiveDataAcknowledged(D &d, uint8_t *data);
+
+        template <class I, class D>
+        static Status _receiveData(D &d, uint8_t *data);
+
+        template <class I, class D>
+        static Status _receiveData(D &d, uint8_t *data, size_t size);
+
+        template <class I, class D>
+        static Status _receiveData(D &d, const ReceiveSegment *segments, size_t count);
+    };
+
+    // Template definitions
+
+    template <class I>
+    MasterPrimitives::Status MasterPrimitives::_checkStatus(uint8_t expected, uint8_t alternative)
+    {
+        uint8_t status = TW_STATUS;
+        I::_record(status);
+        return _getStatus(status, expected, alternative);
+    }
+
+    template <class I>
+    MasterPrimitives::Status MasterPrimitives::_checkStatus(uint8_t expected)
+    {
+        return _checkStatus<I>(expected, expected);
+    }
+
+    template <class I>
+    MasterPrimitives::Status MasterPrimitives::_checkDataStatus(uint8_t expected)
+    {
+        auto s = _checkStatus<I>(expected);
+        if (s == Status::Success)
+            I::_countByte();
+        return s;
+    }
+
+    template <class I, class D>
+    bool MasterPrimitives::_awaitTWINT(D &d)
+    {
+        // Without deadline only TWINT is polled
+        if (d.isUnlimited())
+        {
+            while (!(TWCR & _BV(TWINT)))
+            {
+            }
+            return false;
+        }
+        // micros() disables interrupts and is slow, so it is called only between bursts of polls
+        while (true)
+        {
+            for (uint16_t i = TIMEOUT_CHECK_POLLS; i > 0; i--)
+            {
+                if (TWCR & _BV(TWINT))
+                    return false;
+            }
+            if (d.isExpired())
+            {
+                I::_recordTimeout();
+                return true;
+            }
+        }
+    }
+
+    template <class I, class D>
+    MasterPrimitives::Status MasterPrimitives::_signalStart(D &d)
+    {
+        // Send START condition
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTA));
+        // Wait for TWINT or timeout
+        if (_awaitTWINT<I>(d))
+            return Status::Timeout;
+        // Check status
+        return _checkStatus<I>(TW_START, TW_REP_START);
+    }
+
+    template <class I, class D>
+    MasterPrimitives::Status MasterPrimitives::_signalStopStart(D &d)
+    {
+        I::_recordStop();
+        // Send STOP|START condition
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTO) | _BV(TWSTA));
+        // Wait for TWINT or timeout
+        if (_awaitTWINT<I>(d))
+            return Status::Timeout;
+        // Check status
+        return _checkStatus<I>(TW_START, TW_REP_START);
+    }
+
+    template <class I>
+    void MasterPrimitives::_signalStop()
+    {
+        I::_recordStop();
+        // Send STOP condition
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTO));
+    }
+
+    template <class I, class D>
+    MasterPrimitives::Status MasterPrimitives::_addressSlaveW(D &d, uint8_t address)
+    {
+        // Set address (SLA+W)
+        TWDR = (address << 1) | TW_WRITE;
+        // Send SLA+W
+        TWCR = TWCR_W(_BV(TWINT));
+        // Wait for TWINT or timeout
+        if (_awaitTWINT<I>(d))
+            return Status::Timeout;
+        // Check status
+        return _checkStatus<I>(TW_MT_SLA_ACK);
+    }
+
+    template <class I, class D>
+    MasterPrimitives::Status MasterPrimitives::_sendData(D &d, uint8_t data)
+    {
+        // Set data
+        TWDR = data;
+        // Send data
+        TWCR = TWCR_W(_BV(TWINT));
+        // Wait for TWINT or timeout
+        if (_awaitTWINT<I>(d))
+            return Status::Timeout;
+        // Check status
+        return _checkDataStatus<I>(TW_MT_DATA_ACK);
+    }
+
+    template <class I, class D>
+    MasterPrimitives::Status MasterPrimitives::_sendData(D &d, const uint8_t *data, size_t size)
+    {
+        while (size > 0)
+        {
+            auto s = _sendData<I>(d, *data);
+            if (s != Status::Success)
+                return s;
+            data++;
+            size--;
+        }
+        return Status::Success;
+    }
+
+    template <class I, class D>
+    MasterPrimitives::Status MasterPrimitives::_sendData(D &d, const SendSegment *segments, size_t count)
+    {
+        while (count > 0)
+        {
+            auto s = _sendData<I>(d, segments->data, segments->size);
+            if (s != Status::Success)
+                return s;
+            segments++;
+            count--;
+        }
+        return Status::Success;
+    }
+
+    template <class I, class D>
+    MasterPrimitives::Status MasterPrimitives::_addressSlaveR(D &d, uint8_t address)
+    {
+        // Set address (SLA+R)
+        TWDR = (address << 1) | TW_READ;
+        // Send SLA+R
+        TWCR = TWCR_W(_BV(TWINT));
+        // Wait for TWINT or timeout
+        if (_awaitTWINT<I>(d))
+            return Status::Timeout;
+        // Check status
+        return _checkStatus<I>(TW_MR_SLA_ACK);
+    }
+
+    // TODO: Save TWEA before using it (so it isnt changed after the function)
+    template <class I, class D>
+    MasterPrimitives::Status MasterPrimitives::_receiveData(D &d, uint8_t *data)
+    {
+        // Set to read only 1 byte
+        TWCR &= ~(_BV(TWEA));
+        // Read data
+        TWCR = TWCR_W(_BV(TWINT));
+        // Wait for TWINT or timeout
+        if (_awaitTWINT<I>(d))
+            return Status::Timeout;
+        // Check status
+        auto s = _checkDataStatus<I>(TW_MR_DATA_NACK);
+        if (s == Status::Success)
+            *data = TWDR;
+        return s;
+    }
+
+    template <class I, class D>
+    MasterPrimitives::Status MasterPrimitives::_receiveDataAcknowledged(D &d, uint8_t *data)
+    {
+        // Set to read more than 1 byte
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
+        // Wait for TWINT or timeout
+        if (_awaitTWINT<I>(d))
+            return Status::Timeout;
+        // Check status
+        auto s = _checkDataStatus<I>(TW_MR_DATA_ACK);
+        if (s == Status::Success)
+            *data = TWDR;
+        return s;
+    }
+
+    // TODO: Save TWEA before using it (so it isnt changed after the function)
+    template <class I, class D>
+    MasterPrimitives::Status MasterPrimitives::_receiveData(D &d, uint8_t *data, size_t size)
+    {
+        while (size > 1)
+        {
+            auto s = _receiveDataAcknowledged<I>(d, data);
+            if (s != Status::Success)
+                return s;
+            data++;
+            size--;
+        }
+        return _receiveData<I>(d, data);
+    }
+
+    template <class I, class D>
+    MasterPrimitives::Status MasterPrimitives::_receiveData(D &d, const ReceiveSegment *segments, size_t count)
+    {
+        // Last byte of the whole transfer has to be declined
+        size_t remaining = 0;
+        for (size_t i = 0; i < count; i++)
+            remaining += segments[i].size;
+        while (remaining > 0)
+        {
+            uint8_t *data = segments->data;
+            for (size_t size = segments->size; size > 0; size--)
+            {
+                remaining--;
+                auto s = remaining > 0 ? _receiveDataAcknowledged<I>(d, data) : _receiveData<I>(d, data);
+                if (s != Status::Success)
+                    return s;
+                data++;
+            }
+            segments++;
+        }
+        return Status::Success;
+    }
+}
@@ -0,0 +1,177 @@
+#include "TwoWireMemoryCache.hpp"
+
+#include <string.h>
+
+using namespace TwoWire;
+
+using Status = MemoryCache::Status;
+
+MemoryCache::MemoryCache(MemoryDevice &device, uint8_t *storage, Line *lines, uint8_t lineCount, uint16_t lineSize)
+    : device(device), storage(storage), lines(lines), lineCount(lineCount), lineSize(lineSize), tick(0)
+{
+    invalidate();
+}
+
+uint8_t *MemoryCache::_data(uint8_t index)
+{
+    return storage + (size_t)index * lineSize;
+}
+
+int16_t MemoryCache::_find(uint32_t address)
+{
+    for (uint8_t i = 0; i < lineCount; i++)
+    {
+        if (lines[i].valid && lines[i].address == address)
+            return i;
+    }
+    return -1;
+}
+
+Status MemoryCache::_writeBack(uint8_t index)
+{
+    Line &line = lines[index];
+    if (line.dirtyEnd <= line.dirtyStart)
+        return Status::Success;
+    // Only the modified range is written (memory device splits it on pages)
+    Status s = device.write(line.address + line.dirtyStart, _data(index) + line.dirtyStart, line.dirtyEnd - line.dirtyStart);
+    if (s == Status::Success)
+        line.dirtyStart = line.dirtyEnd = 0;
+    return s;
+}
+
+Status MemoryCache::_allocate(uint32_t address, bool fill, uint8_t &index)
+{
+    // Replace invalid line or the least recently used one
+    index = 0;
+    uint16_t age = 0;
+    for (uint8_t i = 0; i < lineCount; i++)
+    {
+        if (!lines[i].valid)
+        {
+            index = i;
+            break;
+        }
+        // Difference stays correct when the tick overflows
+        uint16_t a = tick - lines[i].used;
+        if (a >= age)
+        {
+            age = a;
+            index = i;
+        }
+    }
+    Line &line = lines[index];
+    if (line.valid)
+    {
+        Status s = _writeBack(index);
+        if (s != Status::Success)
+            return s;
+        line.valid = false;
+    }
+    if (fill)
+    {
+        Status s = device.read(address, _data(index), lineSize);
+        if (s != Status::Success)
+            return s;
+    }
+    line.address = address;
+    line.dirtyStart = line.dirtyEnd = 0;
+    line.valid = true;
+    return Status::Success;
+}
+
+Status MemoryCache::read(uint32_t address, uint8_t *data, size_t size)
+{
+    while (size > 0)
+    {
+        uint16_t offset = address % lineSize;
+        size_t chunk = (size_t)(lineSize - offset) < size ? lineSize - offset : size;
+        int16_t found = _find(address - offset);
+        uint8_t index;
+        if (found >= 0)
+            index = found;
+        else
+        {
+            Status s = _allocate(address - offset, true, index);
+            if (s != Status::Success)
+                return s;
+        }
+        lines[index].used = ++tick;
+        memcpy(data, _data(index) + offset, chunk);
+        address += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+    return Status::Success;
+}
+
+Status MemoryCache::write(uint32_t address, const uint8_t *data, size_t size)
+{
+    while (size > 0)
+    {
+        uint16_t offset = address % lineSize;
+        size_t chunk = (size_t)(lineSize - offset) < size ? lineSize - offset : size;
+        int16_t found = _find(address - offset);
+        uint8_t index;
+        if (found >= 0)
+            index = found;
+        else
+        {
+            // Line is loaded only if it is written partially
+            Status s = _allocate(address - offset, chunk != lineSize, index);
+            if (s != Status::Success)
+                return s;
+        }
+        Line &line = lines[index];
+        line.used = ++tick;
+        memcpy(_data(index) + offset, data, chunk);
+        // Grow the modified range (bytes in between are written again unchanged)
+        if (line.dirtyEnd <= line.dirtyStart)
+        {
+            line.dirtyStart = offset;
+            line.dirtyEnd = offset + chunk;
+        }
+        else
+        {
+            if (offset < line.dirtyStart)
+                line.dirtyStart = offset;
+            if (offset + chunk > line.dirtyEnd)
+                line.dirtyEnd = offset + chunk;
+        }
+        address += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+    return Status::Success;
+}
+
+Status MemoryCache::flush()
+{
+    for (uint8_t i = 0; i < lineCount; i++)
+    {
+        if (!lines[i].valid)
+            continue;
+        Status s = _writeBack(i);
+        if (s != Status::Success)
+            return s;
+    }
+    return Status::Success;
+}
+
+void MemoryCache::invalidate()
+{
+    for (uint8_t i = 0; i < lineCount; i++)
+    {
+        lines[i].valid = false;
+        lines[i].dirtyStart = lines[i].dirtyEnd = 0;
+    }
+}
+
+bool MemoryCache::isDirty()
+{
+    for (uint8_t i = 0; i < lineCount; i++)
+    {
+        if (lines[i].valid && lines[i].dirtyEnd > lines[i].dirtyStart)
+            return true;
+    }
+    return false;
+}
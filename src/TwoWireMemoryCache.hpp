@@ -0,0 +1,110 @@
+#pragma once
+
+#include "TwoWireMemoryDevice.hpp"
+
+namespace TwoWire
+{
+    class MemoryCache
+    {
+    public:
+        using Status = MemoryDevice::Status;
+
+        struct Line
+        {
+            // Memory address of the first byte of the line
+            uint32_t address;
+            // Access tick of the line (for least recently used replacement)
+            uint16_t used;
+            // Range of bytes not yet written to the memory
+            uint16_t dirtyStart;
+            uint16_t dirtyEnd;
+            // Whether the line holds memory contents
+            bool valid;
+        };
+
+    private:
+        MemoryDevice &device;
+        uint8_t *storage;
+        Line *lines;
+        uint8_t lineCount;
+        uint16_t lineSize;
+        uint16_t tick;
+
+        uint8_t *_data(uint8_t index);
+
+        int16_t _find(uint32_t address);
+
+        Status _writeBack(uint8_t index);
+
+        Status _allocate(uint32_t address, bool fill, uint8_t &index);
+
+    public:
+        /**
+         * @brief Get size of the storage needed for the lines
+         *
+         * @param lineSize Size of a line (page size or its divisor for page sized write bursts)
+         * @param lineCount Number of lines
+         * @return size_t Size of the storage
+         */
+        static constexpr size_t getStorageSize(uint16_t lineSize, uint8_t lineCount)
+        {
+            return (size_t)lineSize * lineCount;
+        }
+
+        /**
+         * @brief Create cache of memory device contents
+         *  (reads are served from RAM, writes are kept until the line is evicted or flushed)
+         *
+         * @param device Cached memory device
+         * @param storage Storage for the line data (getStorageSize bytes)
+         * @param lines Storage for the line descriptors
+         * @param lineCount Number of lines
+         * @param lineSize Size of a line
+         */
+        MemoryCache(MemoryDevice &device, uint8_t *storage, Line *lines, uint8_t lineCount, uint16_t lineSize);
+
+        /**
+         * @brief Read memory contents
+         *  (lines that miss are loaded from the memory, least recently used line is replaced)
+         *
+         * @param address Address in the memory
+         * @param data Where to receive the data
+         * @param size Size of the data
+         * @return Status Status of the function
+         */
+        Status read(uint32_t address, uint8_t *data, size_t size);
+
+        /**
+         * @brief Write memory contents
+         *  (written to the memory when the line is evicted or flushed, writes to the same line are coalesced)
+         *
+         * @param address Address in the memory
+         * @param data Data to write
+         * @param size Size of the data
+         * @return Status Status of the function
+         */
+        Status write(uint32_t address, const uint8_t *data, size_t size);
+
+        /**
+         * @brief Write all modified lines to the memory
+         *
+         * @return Status Status of the function
+         */
+        Status flush();
+
+        /**
+         * @brief Drop all lines
+         *  (modified lines which were not flushed are lost)
+         *
+         */
+        void invalidate();
+
+        /**
+         * @brief Check whether any line holds data not yet written to the memory
+         *
+         * @return true Flush is needed
+         * @return false Memory is up to date
+         */
+        bool isDirty();
+    };
+}
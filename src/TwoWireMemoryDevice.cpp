@@ -0,0 +1,6 @@
+#include "TwoWireMemoryDevice.hpp"
+
+namespace TwoWire
+{
+    template class BasicMemoryDevice<MasterConfig>;
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "TwoWireMasterConfiguration.hpp"
+#include "TwoWireMasterConfig.hpp"
+
+namespace TwoWire
+{
+    /**
+     * @brief Memory device (EEPROM, FRAM) driver
+     *
+     * @tparam Master Master used for the transfers (BasicMaster of any policies)
+     */
+    template <class Master>
+    class BasicMemoryDevice
+    {
+    public:
+        using Status = MasterPrimitives::Status;
+
+    private:
+        Master &master;
+        // Acknowledge polling uses bare commands (NACK is expected during the write cycle, so it is neither retried nor counted)
+        MasterConfiguration poll;
+        uint8_t address;
+        uint8_t addressSize;
+        uint16_t pageSize;
+        uint32_t writeTimeout;
+        bool writing;
+
+        uint8_t _encodeAddress(uint32_t memoryAddress, uint8_t *bytes);
+
+        bool _poll(Deadline &deadline);
+
+    public:
+        /**
+         * @brief Create memory device (EEPROM, FRAM) driver
+         *  (memory address bits above addressSize bytes are placed in the low bits of the device address, as on 24C04-24C16)
+         *
+         * @param master Master used for the transfers
+         * @param address Address of the memory device
+         * @param addressSize Size of the memory address in bytes (1 or 2)
+         * @param pageSize Size of the write page (0 for memories without pages and write cycle, e.g. FRAM)
+         * @param writeTimeout Longest write cycle in microseconds
+         */
+        BasicMemoryDevice(Master &master, uint8_t address, uint8_t addressSize, uint16_t pageSize, uint32_t writeTimeout);
+
+        /**
+         * @brief Create memory device (EEPROM, FRAM) driver
+         *  (write cycle times out after 10 ms)
+         *
+         * @param master Master used for the transfers
+         * @param address Address of the memory device
+         * @param addressSize Size of the memory address in bytes (1 or 2)
+         * @param pageSize Size of the write page (0 for memories without pages and write cycle, e.g. FRAM)
+         */
+        BasicMemoryDevice(Master &master, uint8_t address, uint8_t addressSize, uint16_t pageSize);
+
+        /**
+         * @brief Check whether the memory finished its write cycle
+         *  (sends START, SLA+W and STOP once, without the retry policy and statistics of the master)
+         *
+         * @return true Memory is ready
+         * @return false Memory is still writing (or not responding)
+         */
+        bool isReady();
+
+        /**
+         * @brief Wait until the memory finishes its write cycle
+         *  (polls the device address until it is acknowledged)
+         *
+         * @return Status Success once the memory is ready, Timeout if it didn't finish within the write timeout
+         */
+        Status awaitReady();
+
+        /**
+         * @brief Read memory contents
+         *  (any length is read in a single transaction)
+         *
+         * @param memoryAddress Address in the memory
+         * @param data Where to receive the data
+         * @param size Size of the data
+         * @return Status Status of the function
+         */
+        Status read(uint32_t memoryAddress, uint8_t *data, size_t size);
+
+        /**
+         * @brief Write memory contents
+         *  (split on page boundaries, every page waits only for the write cycle of the previous one)
+         *
+         * @param memoryAddress Address in the memory
+         * @param data Data to write
+         * @param size Size of the data
+         * @return Status Status of the function
+         */
+        Status write(uint32_t memoryAddress, const uint8_t *data, size_t size);
+    };
+
+    /**
+     * @brief Memory device driven by MasterConfig
+     *
+     */
+    using MemoryDevice = BasicMemoryDevice<MasterConfig>;
+
+    // Compiled once in TwoWireMemoryDevice.cpp
+    extern template class BasicMemoryDevice<MasterConfig>;
+
+    // Template definitions
+
+    template <class Master>
+    BasicMemoryDevice<Master>::BasicMemoryDevice(Master &master, uint8_t address, uint8_t addressSize, uint16_t pageSize, uint32_t writeTimeout)
+        : master(master), poll(), address(address), addressSize(addressSize), pageSize(pageSize), writeTimeout(writeTimeout), writing(false)
+    {
+    }
+
+    template <class Master>
+    BasicMemoryDevice<Master>::BasicMemoryDevice(Master &master, uint8_t address, uint8_t addressSize, uint16_t pageSize)
+        : BasicMemoryDevice(master, address, addressSize, pageSize, 10000)
+    {
+    }
+
+    template <class Master>
+    uint8_t BasicMemoryDevice<Master>::_encodeAddress(uint32_t memoryAddress, uint8_t *bytes)
+    {
+        // Memory address is big endian
+        for (uint8_t i = addressSize; i > 0; i--)
+        {
+            bytes[i - 1] = (uint8_t)memoryAddress;
+            memoryAddress >>= 8;
+        }
+        // Remaining bits select the block
+        return address | (uint8_t)memoryAddress;
+    }
+
+    template <class Master>
+    bool BasicMemoryDevice<Master>::_poll(Deadline &deadline)
+    {
+        Status s = poll.signalStart(deadline);
+        if (s == Status::Success)
+            s = poll.addressForWriting(address, deadline);
+        switch (s)
+        {
+        case Status::BusLost:
+            // Bus is left to the other master
+            TWCR |= _BV(TWINT);
+            break;
+        case Status::AddressedAsSlave:
+            break;
+        case Status::Error:
+            clearError();
+            break;
+        default:
+            signalStop();
+            break;
+        }
+        return s == Status::Success;
+    }
+
+    template <class Master>
+    bool BasicMemoryDevice<Master>::isReady()
+    {
+        Deadline d{writeTimeout};
+        if (writing && _poll(d))
+            writing = false;
+        return !writing;
+    }
+
+    template <class Master>
+    typename BasicMemoryDevice<Master>::Status BasicMemoryDevice<Master>::awaitReady()
+    {
+        Deadline d{writeTimeout};
+        // Memory doesn't acknowledge its address during the write cycle
+        while (writing)
+        {
+            if (_poll(d))
+                writing = false;
+            else if (d.isExpired())
+                return Status::Timeout;
+        }
+        return Status::Success;
+    }
+
+    template <class Master>
+    typename BasicMemoryDevice<Master>::Status BasicMemoryDevice<Master>::read(uint32_t memoryAddress, uint8_t *data, size_t size)
+    {
+        Status s = awaitReady();
+        if (s != Status::Success)
+            return s;
+        uint8_t bytes[4];
+        uint8_t device = _encodeAddress(memoryAddress, bytes);
+        return master.receiveRegister(device, bytes, addressSize, data, size, true, true);
+    }
+
+    template <class Master>
+    typename BasicMemoryDevice<Master>::Status BasicMemoryDevice<Master>::write(uint32_t memoryAddress, const uint8_t *data, size_t size)
+    {
+        while (size > 0)
+        {
+            // Page write wraps around within the page, so stop at its end
+            size_t chunk = size;
+            if (pageSize != 0 && chunk > pageSize - memoryAddress % pageSize)
+                chunk = pageSize - memoryAddress % pageSize;
+            Status s = awaitReady();
+            if (s != Status::Success)
+                return s;
+            uint8_t bytes[4];
+            uint8_t device = _encodeAddress(memoryAddress, bytes);
+            s = master.writeRegister(device, bytes, addressSize, data, chunk, true);
+            if (s != Status::Success)
+                return s;
+            // Write cycle starts with STOP
+            writing = pageSize != 0;
+            memoryAddress += chunk;
+            data += chunk;
+            size -= chunk;
+        }
+        return Status::Success;
+    }
+}
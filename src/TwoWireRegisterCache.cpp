@@ -0,0 +1,126 @@
+#include "TwoWireRegisterCache.hpp"
+
+using namespace TwoWire;
+
+using Status = RegisterCache::Status;
+
+RegisterCache::RegisterCache(MasterConfig &master, uint8_t address, uint8_t *registers, size_t size, uint8_t *valid, uint8_t *dirty, const uint8_t *volatileMask)
+    : master(master), address(address), registers(registers), size(size), valid(valid), dirty(dirty), volatileMask(volatileMask)
+{
+    invalidate();
+}
+
+RegisterCache::RegisterCache(MasterConfig &master, uint8_t address, uint8_t *registers, size_t size, uint8_t *valid, uint8_t *dirty)
+    : RegisterCache(master, address, registers, size, valid, dirty, nullptr)
+{
+}
+
+bool RegisterCache::_isSet(const uint8_t *mask, uint8_t index)
+{
+    return mask != nullptr && (mask[index >> 3] & _BV(index & 7));
+}
+
+void RegisterCache::_set(uint8_t *mask, uint8_t index, bool value)
+{
+    if (value)
+        mask[index >> 3] |= _BV(index & 7);
+    else
+        mask[index >> 3] &= ~_BV(index & 7);
+}
+
+void RegisterCache::setVolatileMask(const uint8_t *mask)
+{
+    volatileMask = mask;
+}
+
+Status RegisterCache::read(uint8_t index, uint8_t *value)
+{
+    if (_isSet(valid, index))
+    {
+        *value = registers[index];
+        return Status::Success;
+    }
+    Status s = master.receiveRegister(address, index, value, true);
+    if (s == Status::Success && !_isSet(volatileMask, index))
+    {
+        registers[index] = *value;
+        _set(valid, index, true);
+    }
+    return s;
+}
+
+Status RegisterCache::write(uint8_t index, uint8_t value)
+{
+    if (_isSet(volatileMask, index))
+        return master.writeRegister(address, index, value);
+    registers[index] = value;
+    _set(valid, index, true);
+    _set(dirty, index, true);
+    return Status::Success;
+}
+
+Status RegisterCache::updateBits(uint8_t index, uint8_t mask, uint8_t value)
+{
+    uint8_t current;
+    Status s = read(index, &current);
+    if (s != Status::Success)
+        return s;
+    uint8_t updated = (current & ~mask) | (value & mask);
+    // Unchanged cached register doesn't need a write (volatile one is written anyway)
+    if (updated == current && !_isSet(volatileMask, index))
+        return Status::Success;
+    return write(index, updated);
+}
+
+Status RegisterCache::sync()
+{
+    size_t i = 0;
+    while (i < size)
+    {
+        // Skip whole clean mask bytes
+        if (dirty[i >> 3] == 0)
+        {
+            i = (i | 7) + 1;
+            continue;
+        }
+        if (!_isSet(dirty, i))
+        {
+            i++;
+            continue;
+        }
+        // Find the end of the run of dirty registers
+        size_t end = i + 1;
+        while (end < size && _isSet(dirty, end))
+            end++;
+        Status s = master.writeRegister(address, (uint8_t)i, registers + i, end - i);
+        if (s != Status::Success)
+            return s;
+        for (; i < end; i++)
+            _set(dirty, i, false);
+    }
+    return Status::Success;
+}
+
+void RegisterCache::invalidate()
+{
+    for (size_t i = 0; i < getMaskSize(size); i++)
+    {
+        valid[i] = 0;
+        dirty[i] = 0;
+    }
+}
+
+bool RegisterCache::isDirty(uint8_t index)
+{
+    return _isSet(dirty, index);
+}
+
+bool RegisterCache::isDirty()
+{
+    for (size_t i = 0; i < getMaskSize(size); i++)
+    {
+        if (dirty[i])
+            return true;
+    }
+    return false;
+}
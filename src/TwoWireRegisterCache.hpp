@@ -0,0 +1,123 @@
+#pragma once
+
+#include "TwoWireMasterConfig.hpp"
+
+namespace TwoWire
+{
+    class RegisterCache
+    {
+    public:
+        using Status = MasterConfig::Status;
+
+    private:
+        MasterConfig &master;
+        uint8_t address;
+        uint8_t *registers;
+        size_t size;
+        uint8_t *valid;
+        uint8_t *dirty;
+        const uint8_t *volatileMask;
+
+        static bool _isSet(const uint8_t *mask, uint8_t index);
+
+        static void _set(uint8_t *mask, uint8_t index, bool value);
+
+    public:
+        /**
+         * @brief Get size of a mask covering the registers
+         *
+         * @param size Number of registers
+         * @return size_t Size of the mask in bytes (one bit per register)
+         */
+        static constexpr size_t getMaskSize(size_t size)
+        {
+            return (size + 7) / 8;
+        }
+
+        /**
+         * @brief Create register cache of a slave device
+         *  (registers are read from the device once, writes are deferred until sync)
+         *
+         * @param master Master used for the transfers
+         * @param address Address of the slave device
+         * @param registers Storage for the cached register values
+         * @param size Number of registers (at most 256)
+         * @param valid Mask of cached registers (getMaskSize(size) bytes)
+         * @param dirty Mask of registers waiting for sync (getMaskSize(size) bytes)
+         * @param volatileMask Mask of registers changed by the device itself (getMaskSize(size) bytes, can be nullptr)
+         */
+        RegisterCache(MasterConfig &master, uint8_t address, uint8_t *registers, size_t size, uint8_t *valid, uint8_t *dirty, const uint8_t *volatileMask);
+        RegisterCache(MasterConfig &master, uint8_t address, uint8_t *registers, size_t size, uint8_t *valid, uint8_t *dirty);
+
+        /**
+         * @brief Set mask of registers changed by the device itself
+         *  (volatile registers are never cached, they are always read and written immediately)
+         *
+         * @param mask Mask (getMaskSize(size) bytes, can be nullptr)
+         */
+        void setVolatileMask(const uint8_t *mask);
+
+        /**
+         * @brief Read register
+         *  (served from the cache if the register is cached)
+         *
+         * @param index Register index
+         * @param value Where to store the value
+         * @return Status Status of the function
+         */
+        Status read(uint8_t index, uint8_t *value);
+
+        /**
+         * @brief Write register
+         *  (non volatile registers are written to the device on sync)
+         *
+         * @param index Register index
+         * @param value Value to write
+         * @return Status Status of the function
+         */
+        Status write(uint8_t index, uint8_t value);
+
+        /**
+         * @brief Change bits of register
+         *  (read from the cache if possible, nothing is written if the value doesn't change)
+         *
+         * @param index Register index
+         * @param mask Bits to change
+         * @param value New value of the bits
+         * @return Status Status of the function
+         */
+        Status updateBits(uint8_t index, uint8_t mask, uint8_t value);
+
+        /**
+         * @brief Write registers waiting for sync to the device
+         *  (runs of adjacent registers are written in a single auto-increment transaction)
+         *
+         * @return Status Status of the function
+         */
+        Status sync();
+
+        /**
+         * @brief Drop cached register values
+         *  (registers waiting for sync are dropped too, sync first to keep the writes)
+         *
+         */
+        void invalidate();
+
+        /**
+         * @brief Check whether the register is waiting for sync
+         *
+         * @param index Register index
+         * @return true Register has to be written
+         * @return false Register is up to date
+         */
+        bool isDirty(uint8_t index);
+
+        /**
+         * @brief Check whether any register is waiting for sync
+         *
+         * @return true Sync is needed
+         * @return false Device is up to date
+         */
+        bool isDirty();
+    };
+}
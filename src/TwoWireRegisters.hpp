@@ -0,0 +1,17 @@
+#pragma once
+
+// Register backend (TWCR, TWDR, TWSR, TWAR, TWAMR, TWBR and TW_* status codes)
+// can be replaced by defining TWOWIRE_REGISTERS as a header name,
+// by default AVR registers are accessed directly
+#ifdef TWOWIRE_REGISTERS
+#include TWOWIRE_REGISTERS
+#else
+#include <avr/io.h>
+#include <compat/twi.h>
+#endif
+
+#define TWCR_UNUSED (TWCR & (_BV(TWEA) | _BV(TWWC) | _BV(TWEN) | _BV(TWIE)))
+#define TWCR_W(d) ((d) | TWCR_UNUSED)
+
+// Keeps the compiler from reordering memory accesses shared with the TWI interrupt
+#define MEMORY_BARRIER() __asm__ __volatile__("" ::: "memory")
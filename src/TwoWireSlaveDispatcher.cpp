@@ -0,0 +1,85 @@
+#include "TwoWireSlaveDispatcher.hpp"
+
+#include "TwoWireCore.hpp"
+#include "TwoWireStatusTable.hpp"
+
+#include "TwoWireRegisters.hpp"
+
+using namespace TwoWire;
+
+SlaveDispatcher::SlaveDispatcher(uint8_t baseAddress, const Handler *handlers, uint8_t count)
+    : baseAddress(baseAddress), handlers(handlers), count(count), active(nullptr)
+{
+}
+
+void SlaveDispatcher::_refuse(uint8_t status)
+{
+    switch (StatusTable::getSlaveBasicStatus(status))
+    {
+    case Slave::BasicStatus::AddressedAsReceiver:
+    case Slave::BasicStatus::DataReceived:
+        // Refuse data
+        TWCR = TWCR_W(_BV(TWINT)) & ~_BV(TWEA);
+        break;
+    case Slave::BasicStatus::AddressedAsTransmitter:
+    case Slave::BasicStatus::SentDataAccepted:
+        // Send a single filler byte
+        TWDR = 0xFF;
+        TWCR = TWCR_W(_BV(TWINT)) & ~_BV(TWEA);
+        break;
+    default:
+        // Let the master address us again
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
+        break;
+    }
+}
+
+void SlaveDispatcher::setAddresses()
+{
+    TwoWire::setAddress(baseAddress);
+    TwoWire::setAddressMask(getAddressMask(baseAddress, count));
+}
+
+uint8_t SlaveDispatcher::getActiveAddress()
+{
+    const Handler *handler = active;
+    return handler != nullptr ? baseAddress + (handler - handlers) : 0;
+}
+
+void SlaveDispatcher::interruptVectorRoutine()
+{
+    uint8_t status = TW_STATUS;
+    switch (StatusTable::getSlaveStatus(status))
+    {
+    case Slave::Status::DirectlyAddressedAsReceiver:
+    case Slave::Status::BusLostDirectlyAddressedAsReceiver:
+    case Slave::Status::DirectlyAddressedAsTransmitter:
+    case Slave::Status::BusLostDirectlyAddressedAsTransmitter:
+    {
+        // Matched SLA+R/W is still in TWDR
+        uint8_t index = (TWDR >> 1) - baseAddress;
+        active = index < count && handlers[index].routine != nullptr ? &handlers[index] : nullptr;
+        break;
+    }
+    case Slave::Status::GeneralCallAddressedAsReceiver:
+    case Slave::Status::BusLostGeneralCallAdressedAsReceiver:
+        // General call isn't routed
+        active = nullptr;
+        break;
+    default:
+        break;
+    }
+    if (active != nullptr)
+        active->routine(active->object);
+    // Status the handler left unhandled (or no handler at the address)
+    if (TWCR & _BV(TWINT))
+        _refuse(status);
+    // Transaction ends when the slave returns to not addressed mode
+    if (StatusTable::endsSlaveTransaction(status))
+    {
+        active = nullptr;
+        // Handlers clear TWEA when they can't take more data,
+        // the other addresses have to stay reachable (START requested by the master is kept)
+        TWCR = (TWCR & ~_BV(TWINT)) | _BV(TWEA);
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace TwoWire
+{
+    struct SlaveHandler
+    {
+        // Routine handling the transaction (nullptr if nothing answers at the address)
+        void (*routine)(void *object);
+        // Object passed to the routine
+        void *object;
+    };
+
+    class SlaveDispatcher
+    {
+    public:
+        using Handler = SlaveHandler;
+
+    private:
+        uint8_t baseAddress;
+        const Handler *handlers;
+        uint8_t count;
+        const Handler *active;
+
+        template <class T>
+        static void _call(void *object)
+        {
+            ((T *)object)->interruptVectorRoutine();
+        }
+
+        void _refuse(uint8_t status);
+
+    public:
+        /**
+         * @brief Create handler routing transactions to a slave class
+         *  (SlaveReceiver, SlaveFrameReceiver, SlaveTransmitter, SlaveRegisterMap or anything with interruptVectorRoutine)
+         * 
+         * @param object Slave object
+         * @return Handler Handler
+         */
+        template <class T>
+        static constexpr Handler handler(T &object)
+        {
+            return {&_call<T>, &object};
+        }
+
+        /**
+         * @brief Create handler that doesn't answer at the address
+         * 
+         * @return Handler Handler
+         */
+        static constexpr Handler none()
+        {
+            return {nullptr, nullptr};
+        }
+
+        /**
+         * @brief Get address mask accepting a range of addresses
+         *  (ranges not aligned to a power of two also match addresses outside of the range, those are refused)
+         * 
+         * @param baseAddress First address of the range
+         * @param count Number of addresses
+         * @return uint8_t Address mask (for TwoWire::setAddressMask)
+         */
+        static constexpr uint8_t getAddressMask(uint8_t baseAddress, uint8_t count)
+        {
+            return count <= 1 ? 0 : (((baseAddress + count - 1) ^ baseAddress) | getAddressMask(baseAddress, count - 1)) & 0x7F;
+        }
+
+        /**
+         * @brief Create Slave dispatcher
+         * 
+         * @param baseAddress Address of the first handler
+         * @param handlers Handlers of consecutive addresses (indexed by address - baseAddress)
+         * @param count Number of handlers
+         */
+        SlaveDispatcher(uint8_t baseAddress, const Handler *handlers, uint8_t count);
+
+        /**
+         * @brief Set TWI address and address mask to accept all addresses of the handlers
+         * 
+         */
+        void setAddresses();
+
+        /**
+         * @brief Get address of the transaction in progress
+         * 
+         * @return uint8_t Matched address (0 if no transaction is in progress)
+         */
+        uint8_t getActiveAddress();
+
+        /**
+         * @brief Function to be called in TWI Interrupt Service Routine
+         * 
+         */
+        void interruptVectorRoutine();
+    };
+}
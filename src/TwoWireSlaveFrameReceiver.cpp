@@ -0,0 +1,137 @@
+#include "TwoWireSlaveFrameReceiver.hpp"
+
+#include "TwoWireCore.hpp"
+#include "TwoWireStatusTable.hpp"
+#include "TwoWireStatistics.hpp"
+#include "TwoWireTrace.hpp"
+
+#include "TwoWireRegisters.hpp"
+
+using namespace TwoWire;
+
+SlaveFrameReceiver::SlaveFrameReceiver(uint8_t *data, size_t size, Frame *frames, uint8_t count)
+    : data(data), size(size), frames(frames), capacity(count), head(0), frameHead(0),
+      start(0), length(0), generalCall(false), truncated(false), accepting(false), frameTail(0)
+{
+}
+
+uint8_t SlaveFrameReceiver::_nextFrame(uint8_t index)
+{
+    return index + 1 < capacity ? index + 1 : 0;
+}
+
+size_t SlaveFrameReceiver::_getFree()
+{
+    // Oldest byte still in use (first byte of the current frame if the queue is empty)
+    uint8_t tail = frameTail;
+    MEMORY_BARRIER();
+    size_t used = tail != frameHead ? frames[tail].offset : start;
+    return (used > head ? used - head : size - head + used) - 1;
+}
+
+void SlaveFrameReceiver::_continue()
+{
+    // Acknowledge next data only if there is space for it
+    TWCR = (TWCR_W(_BV(TWINT)) & ~_BV(TWEA)) | (accepting && _getFree() > 0 ? _BV(TWEA) : 0);
+}
+
+void SlaveFrameReceiver::_close()
+{
+    if (accepting && length > 0)
+    {
+        frames[frameHead] = {start, length, generalCall, truncated};
+        MEMORY_BARRIER();
+        frameHead = _nextFrame(frameHead);
+    }
+    start = head;
+    length = 0;
+    accepting = false;
+}
+
+bool SlaveFrameReceiver::isFrameAvailable()
+{
+    return frameTail != frameHead;
+}
+
+size_t SlaveFrameReceiver::getFrameSize()
+{
+    MEMORY_BARRIER();
+    return frames[frameTail].length;
+}
+
+bool SlaveFrameReceiver::isGeneralCall()
+{
+    MEMORY_BARRIER();
+    return frames[frameTail].generalCall;
+}
+
+bool SlaveFrameReceiver::isTruncated()
+{
+    MEMORY_BARRIER();
+    return frames[frameTail].truncated;
+}
+
+uint8_t SlaveFrameReceiver::getFrameData(size_t index)
+{
+    MEMORY_BARRIER();
+    size_t offset = frames[frameTail].offset + index;
+    return data[offset < size ? offset : offset - size];
+}
+
+size_t SlaveFrameReceiver::readFrame(uint8_t *data, size_t size)
+{
+    size_t length = getFrameSize();
+    if (length > size)
+        length = size;
+    for (size_t i = 0; i < length; i++)
+        data[i] = getFrameData(i);
+    return length;
+}
+
+void SlaveFrameReceiver::nextFrame()
+{
+    if (!isFrameAvailable())
+        return;
+    MEMORY_BARRIER();
+    frameTail = _nextFrame(frameTail);
+}
+
+void SlaveFrameReceiver::interruptVectorRoutine()
+{
+    uint8_t status = TW_STATUS;
+    Trace::_record(status);
+    Statistics::_countSlaveStatus(status);
+    switch (StatusTable::getSlaveBasicStatus(status))
+    {
+    case Slave::BasicStatus::AddressedAsReceiver:
+        start = head;
+        length = 0;
+        generalCall = status == TW_SR_GCALL_ACK || status == TW_SR_ARB_LOST_GCALL_ACK;
+        truncated = false;
+        // Frame needs a free descriptor
+        accepting = _nextFrame(frameHead) != frameTail;
+        _continue();
+        break;
+    case Slave::BasicStatus::DataReceived:
+        data[head] = TWDR;
+        head = head + 1 < size ? head + 1 : 0;
+        length++;
+        _continue();
+        break;
+    case Slave::BasicStatus::LastDataReceived:
+        // Data is refused only when the byte ring is full (accepted frame), the frame ends without it
+        truncated = true;
+        _close();
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
+        break;
+    case Slave::BasicStatus::SignalReceived:
+        // STOP or repeated START closes the frame
+        _close();
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
+        break;
+    default:
+        // Release the bus after bus error
+        StatusTable::applyAction(status);
+        break;
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace TwoWire
+{
+    class SlaveFrameReceiver
+    {
+    public:
+        struct Frame
+        {
+            // Offset of the first byte in the byte ring
+            size_t offset;
+            // Number of bytes
+            size_t length;
+            // Whether the frame was sent to the general call address
+            bool generalCall;
+            // Whether data was refused because the byte ring was full (frame holds only the bytes that fit)
+            bool truncated;
+        };
+
+    private:
+        uint8_t *data;
+        size_t size;
+        Frame *frames;
+        uint8_t capacity;
+        // Written only by the interrupt
+        size_t head;
+        volatile uint8_t frameHead;
+        size_t start;
+        size_t length;
+        bool generalCall;
+        bool truncated;
+        bool accepting;
+        // Written only by the main loop
+        volatile uint8_t frameTail;
+
+        uint8_t _nextFrame(uint8_t index);
+
+        size_t _getFree();
+
+        void _continue();
+
+        void _close();
+
+    public:
+        /**
+         * @brief Construct Slave frame receiver
+         *  (every STOP or repeated START closes a frame, data that doesn't fit is NACKed
+         *  and the frame is marked truncated)
+         * 
+         * @param data Byte ring storing data of the frames (one byte is kept free)
+         * @param size Size of the byte ring
+         * @param frames Frame descriptor ring (one descriptor is kept free)
+         * @param count Number of frame descriptors
+         */
+        SlaveFrameReceiver(uint8_t *data, size_t size, Frame *frames, uint8_t count);
+
+        /**
+         * @brief Check whether a complete frame is available
+         * 
+         * @return true Frame is available
+         * @return false Still waiting for a frame
+         */
+        bool isFrameAvailable();
+
+        /**
+         * @brief Get size of the oldest frame
+         * 
+         * @return size_t Number of bytes in the frame
+         */
+        size_t getFrameSize();
+
+        /**
+         * @brief Check whether the oldest frame was sent to the general call address
+         * 
+         * @return true Frame was sent to the general call address
+         * @return false Frame was sent to our address
+         */
+        bool isGeneralCall();
+
+        /**
+         * @brief Check whether the oldest frame was cut short because the byte ring was full
+         *  (it holds only the bytes that fit, the rest of the message was NACKed)
+         * 
+         * @return true Frame is incomplete
+         * @return false Frame holds the whole message
+         */
+        bool isTruncated();
+
+        /**
+         * @brief Get byte of the oldest frame
+         * 
+         * @param index Index of the byte in the frame
+         * @return uint8_t Byte
+         */
+        uint8_t getFrameData(size_t index);
+
+        /**
+         * @brief Copy the oldest frame
+         * 
+         * @param data Where to copy the frame
+         * @param size Size of the storage (longer frame is truncated)
+         * @return size_t Number of bytes copied
+         */
+        size_t readFrame(uint8_t *data, size_t size);
+
+        /**
+         * @brief Release the oldest frame
+         *  (its space is reused for new data, doesn't disable interrupts)
+         * 
+         */
+        void nextFrame();
+
+        /**
+         * @brief Function to be called in TWI Interrupt Service Routine
+         * 
+         */
+        void interruptVectorRoutine();
+    };
+}
@@ -1,83 +1,161 @@
 #include "TwoWireSlaveReceiver.hpp"
 
 #include "TwoWireCore.hpp"
+#include "TwoWireStatusTable.hpp"
+#include "TwoWireStatistics.hpp"
+#include "TwoWireTrace.hpp"
 
-#include <compat/twi.h>
+#include "TwoWireRegisters.hpp"
+#include <util/atomic.h>
 
 using namespace TwoWire;
 
 SlaveReceiver::SlaveReceiver(uint8_t *data, size_t size)
-    : data(data), size(size), count(0)
+    : single{data, size, 0}, buffers(&single), capacity(1), fill(0), first(0), ready(0)
 {
 }
 
 SlaveReceiver::SlaveReceiver(uint8_t *data)
-    : data(data), size(1), count(0)
+    : SlaveReceiver(data, 1)
 {
 }
 
-SlaveReceiver::SlaveReceiver()
-    : data(nullptr), size(0), count(0)
+SlaveReceiver::SlaveReceiver(Buffer *buffers, uint8_t count)
+    : single{nullptr, 0, 0}, buffers(buffers), capacity(count), fill(0), first(0), ready(0)
 {
 }
 
-void SlaveReceiver::receiveNextData()
+SlaveReceiver::SlaveReceiver()
+    : SlaveReceiver((uint8_t *)nullptr, 0)
 {
-    this->count = 0;
 }
 
-void SlaveReceiver::receiveNextData(uint8_t *data, size_t size)
+bool SlaveReceiver::_isAccepting()
 {
-    this->data = data;
-    this->size = size;
-    this->count = 0;
+    // Buffer being filled is free
+    return ready < capacity && buffers[fill].size > 0;
 }
 
-void SlaveReceiver::receiveNextData(uint8_t *data)
+void SlaveReceiver::_complete()
 {
-    this->data = data;
-    this->size = 1;
-    this->count = 0;
+    // Nothing received or all buffers are completed already
+    if (ready >= capacity || buffers[fill].count == 0)
+        return;
+    ready++;
+    fill = fill + 1 < capacity ? fill + 1 : 0;
+    if (ready < capacity)
+        buffers[fill].count = 0;
 }
 
-bool SlaveReceiver::isDataAvailable()
+void SlaveReceiver::_continue()
 {
-    return size == count;
+    // Acknowledge next data only if there is space for it
+    TWCR = (TWCR_W(_BV(TWINT)) & ~_BV(TWEA)) | (_isAccepting() ? _BV(TWEA) : 0);
 }
 
-void SlaveReceiver::interruptVectorRoutine()
+void SlaveReceiver::_release()
 {
-    switch (TW_STATUS)
+    // Let the master address us again (TWINT and a pending TWSTA of the master are left untouched)
+    if (_isAccepting())
     {
-    case TW_SR_SLA_ACK:
-    case TW_SR_ARB_LOST_SLA_ACK:
-    case TW_SR_GCALL_ACK:
-    case TW_SR_ARB_LOST_GCALL_ACK:
-        if (count < size)
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
         {
-            TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
-            count = 0;
+            TWCR = (TWCR & ~_BV(TWINT)) | _BV(TWEA);
         }
-        else
-        {
-            TWCR &= ~(_BV(TWEA));
-            TWCR = TWCR_W(_BV(TWINT));
-        }
-        break;
-    case TW_SR_DATA_ACK:
-    case TW_SR_GCALL_DATA_ACK:
-        data[count] = TWDR;
-        count++;
-        if (count < size)
+    }
+}
+
+void SlaveReceiver::receiveNextData()
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (ready > 0)
         {
-            TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
+            first = first + 1 < capacity ? first + 1 : 0;
+            ready--;
+            if (ready == capacity - 1)
+                buffers[fill].count = 0;
         }
         else
         {
-            TWCR &= ~(_BV(TWEA));
-            TWCR = TWCR_W(_BV(TWINT));
+            buffers[fill].count = 0;
         }
+        _release();
+    }
+}
+
+void SlaveReceiver::receiveNextData(uint8_t *data, size_t size)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        single = {data, size, 0};
+        buffers = &single;
+        capacity = 1;
+        fill = 0;
+        first = 0;
+        ready = 0;
+        _release();
+    }
+}
+
+void SlaveReceiver::receiveNextData(uint8_t *data)
+{
+    receiveNextData(data, 1);
+}
+
+bool SlaveReceiver::isDataAvailable()
+{
+    return ready > 0;
+}
+
+uint8_t *SlaveReceiver::getData()
+{
+    return buffers[first].data;
+}
+
+size_t SlaveReceiver::getDataSize()
+{
+    return buffers[first].count;
+}
+
+void SlaveReceiver::interruptVectorRoutine()
+{
+    uint8_t status = TW_STATUS;
+    Trace::_record(status);
+    Statistics::_countSlaveStatus(status);
+    switch (StatusTable::getSlaveBasicStatus(status))
+    {
+    case Slave::BasicStatus::AddressedAsReceiver:
+        // Drop data of an unfinished transaction
+        if (_isAccepting())
+            buffers[fill].count = 0;
+        _continue();
+        break;
+    case Slave::BasicStatus::DataReceived:
+    {
+        Buffer &buffer = buffers[fill];
+        buffer.data[buffer.count] = TWDR;
+        buffer.count++;
+        // Hand the full buffer to the main loop and continue with the next one
+        if (buffer.count == buffer.size)
+            _complete();
+        _continue();
+        break;
+    }
+    case Slave::BasicStatus::LastDataReceived:
+        // Refused data is dropped
+        _continue();
+        break;
+    case Slave::BasicStatus::SignalReceived:
+        // STOP or repeated START ends the data of a ping-pong buffer
+        // (single storage location is completed only once filled)
+        if (buffers != &single)
+            _complete();
+        _continue();
+        break;
+    default:
+        // Release the bus after bus error
+        StatusTable::applyAction(status);
         break;
-    // Ignore NACK
     }
 }
@@ -7,10 +7,30 @@ namespace TwoWire
 {
     class SlaveReceiver
     {
+    public:
+        struct Buffer
+        {
+            uint8_t *data;
+            size_t size;
+            // Number of bytes received
+            size_t count;
+        };
+
     private:
-        uint8_t *data;
-        size_t size;
-        size_t count;
+        Buffer single;
+        Buffer *buffers;
+        uint8_t capacity;
+        uint8_t fill;
+        uint8_t first;
+        volatile uint8_t ready;
+
+        bool _isAccepting();
+
+        void _complete();
+
+        void _continue();
+
+        void _release();
 
     public:
         /**
@@ -28,6 +48,16 @@ namespace TwoWire
          */
         SlaveReceiver(uint8_t *data);
 
+        /**
+         * @brief Construct Slave receiver with multiple save locations (ping-pong)
+         *  (next buffer is filled while the main loop processes the completed ones,
+         *  a buffer is completed once filled or by STOP, so it can hold fewer bytes than its size)
+         * 
+         * @param buffers Buffers to which data will be stored
+         * @param count Number of buffers
+         */
+        SlaveReceiver(Buffer *buffers, uint8_t count);
+
         /**
          * @brief Construct Slave receiver
          *  (data location has to be specified before the class is able to receive any data)
@@ -37,6 +67,7 @@ namespace TwoWire
 
         /**
          * @brief Instruct to receive data to the same storage location
+         *  (releases the completed buffer, data is acknowledged again if it was refused)
          * 
          */
         void receiveNextData();
@@ -51,13 +82,28 @@ namespace TwoWire
         void receiveNextData(uint8_t *data);
 
         /**
-         * @brief Check whether the storage location has been filled
+         * @brief Check whether a storage location has been completed
+         *  (filled, with multiple save locations also ended by STOP)
          * 
          * @return true Storage location is filled with data
          * @return false Still waiting for data
          */
         bool isDataAvailable();
 
+        /**
+         * @brief Get the oldest completed storage location
+         * 
+         * @return uint8_t* Received data
+         */
+        uint8_t *getData();
+
+        /**
+         * @brief Get number of bytes received to the oldest completed storage location
+         * 
+         * @return size_t Number of received bytes
+         */
+        size_t getDataSize();
+
         /**
          * @brief Function to be called in TWI Interrupt Service Routine
          * 
@@ -0,0 +1,147 @@
+#include "TwoWireSlaveRegisterMap.hpp"
+
+#include "TwoWireCore.hpp"
+#include "TwoWireStatusTable.hpp"
+#include "TwoWireStatistics.hpp"
+#include "TwoWireTrace.hpp"
+
+#include "TwoWireRegisters.hpp"
+#include <util/atomic.h>
+
+using namespace TwoWire;
+
+SlaveRegisterMap::SlaveRegisterMap(uint8_t *registers, size_t size, uint8_t *dirty, const uint8_t *readOnly, const uint8_t *writeOnly)
+    : registers(registers), size(size), dirty(dirty), readOnly(readOnly), writeOnly(writeOnly), pointer(0), pointerSet(false)
+{
+}
+
+SlaveRegisterMap::SlaveRegisterMap(uint8_t *registers, size_t size, uint8_t *dirty)
+    : SlaveRegisterMap(registers, size, dirty, nullptr, nullptr)
+{
+}
+
+SlaveRegisterMap::SlaveRegisterMap(uint8_t *registers, size_t size)
+    : SlaveRegisterMap(registers, size, nullptr, nullptr, nullptr)
+{
+}
+
+bool SlaveRegisterMap::_isSet(const uint8_t *mask, uint8_t index)
+{
+    return mask != nullptr && (mask[index >> 3] & _BV(index & 7));
+}
+
+void SlaveRegisterMap::_advance()
+{
+    // Wrap around at the end of the map
+    pointer = (size_t)pointer + 1 < size ? pointer + 1 : 0;
+}
+
+void SlaveRegisterMap::_write(uint8_t data)
+{
+    if (pointer < size && !_isSet(readOnly, pointer))
+    {
+        registers[pointer] = data;
+        if (dirty != nullptr)
+            dirty[pointer >> 3] |= _BV(pointer & 7);
+    }
+    _advance();
+}
+
+uint8_t SlaveRegisterMap::_read()
+{
+    uint8_t data = pointer < size && !_isSet(writeOnly, pointer) ? registers[pointer] : 0xFF;
+    _advance();
+    return data;
+}
+
+void SlaveRegisterMap::setReadOnlyMask(const uint8_t *mask)
+{
+    readOnly = mask;
+}
+
+void SlaveRegisterMap::setWriteOnlyMask(const uint8_t *mask)
+{
+    writeOnly = mask;
+}
+
+bool SlaveRegisterMap::isDirty(uint8_t index)
+{
+    return dirty != nullptr && (dirty[index >> 3] & _BV(index & 7));
+}
+
+bool SlaveRegisterMap::isDirty()
+{
+    if (dirty == nullptr)
+        return false;
+    for (size_t i = 0; i < getMaskSize(size); i++)
+    {
+        if (dirty[i])
+            return true;
+    }
+    return false;
+}
+
+void SlaveRegisterMap::clearDirty(uint8_t index)
+{
+    if (dirty == nullptr)
+        return;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        dirty[index >> 3] &= ~_BV(index & 7);
+    }
+}
+
+void SlaveRegisterMap::clearDirty()
+{
+    if (dirty == nullptr)
+        return;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        for (size_t i = 0; i < getMaskSize(size); i++)
+            dirty[i] = 0;
+    }
+}
+
+uint8_t SlaveRegisterMap::getPointer()
+{
+    return pointer;
+}
+
+void SlaveRegisterMap::interruptVectorRoutine()
+{
+    uint8_t status = TW_STATUS;
+    Trace::_record(status);
+    Statistics::_countSlaveStatus(status);
+    switch (StatusTable::getSlaveBasicStatus(status))
+    {
+    case Slave::BasicStatus::AddressedAsReceiver:
+        // Next byte is the register pointer
+        pointerSet = false;
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
+        break;
+    case Slave::BasicStatus::DataReceived:
+        if (!pointerSet)
+        {
+            // Compared instead of divided, the bus is stretched meanwhile
+            uint8_t data = TWDR;
+            pointer = data < size ? data : 0;
+            pointerSet = true;
+        }
+        else
+        {
+            _write(TWDR);
+        }
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
+        break;
+    case Slave::BasicStatus::AddressedAsTransmitter:
+    case Slave::BasicStatus::SentDataAccepted:
+        // Stream from the register pointer until the master NACKs
+        TWDR = _read();
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
+        break;
+    default:
+        // Release the bus after NACK, STOP or bus error
+        StatusTable::applyAction(status);
+        break;
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace TwoWire
+{
+    class SlaveRegisterMap
+    {
+    private:
+        uint8_t *registers;
+        size_t size;
+        // Written by the interrupt, read by the main loop
+        volatile uint8_t *dirty;
+        const uint8_t *readOnly;
+        const uint8_t *writeOnly;
+        uint8_t pointer;
+        bool pointerSet;
+
+        static bool _isSet(const uint8_t *mask, uint8_t index);
+
+        void _advance();
+
+        void _write(uint8_t data);
+
+        uint8_t _read();
+
+    public:
+        /**
+         * @brief Get size of a mask covering the registers
+         * 
+         * @param size Number of registers
+         * @return size_t Size of the mask in bytes (one bit per register)
+         */
+        static constexpr size_t getMaskSize(size_t size)
+        {
+            return (size + 7) / 8;
+        }
+
+        /**
+         * @brief Construct Slave register map
+         *  (first written byte sets the register pointer, following writes and reads auto-increment it,
+         *  pointer out of the map starts at register 0, a map of size 0 ignores writes and reads return 0xFF)
+         * 
+         * @param registers Register storage
+         * @param size Number of registers (at most 256)
+         * @param dirty Mask of registers written by the master (getMaskSize(size) bytes, can be nullptr)
+         * @param readOnly Mask of registers the master can't write (getMaskSize(size) bytes, can be nullptr)
+         * @param writeOnly Mask of registers the master can't read (getMaskSize(size) bytes, can be nullptr)
+         */
+        SlaveRegisterMap(uint8_t *registers, size_t size, uint8_t *dirty, const uint8_t *readOnly, const uint8_t *writeOnly);
+        SlaveRegisterMap(uint8_t *registers, size_t size, uint8_t *dirty);
+        SlaveRegisterMap(uint8_t *registers, size_t size);
+
+        /**
+         * @brief Set mask of registers the master can't write
+         *  (writes to them are acknowledged and ignored)
+         * 
+         * @param mask Mask (getMaskSize(size) bytes, can be nullptr)
+         */
+        void setReadOnlyMask(const uint8_t *mask);
+
+        /**
+         * @brief Set mask of registers the master can't read
+         *  (reads of them return 0xFF)
+         * 
+         * @param mask Mask (getMaskSize(size) bytes, can be nullptr)
+         */
+        void setWriteOnlyMask(const uint8_t *mask);
+
+        /**
+         * @brief Check whether the master wrote the register since its dirty flag was cleared
+         * 
+         * @param index Register index
+         * @return true Register was written
+         * @return false Register wasn't written
+         */
+        bool isDirty(uint8_t index);
+
+        /**
+         * @brief Check whether the master wrote any register since the dirty flags were cleared
+         * 
+         * @return true Some register was written
+         * @return false No register was written
+         */
+        bool isDirty();
+
+        /**
+         * @brief Clear dirty flag of the register
+         * 
+         * @param index Register index
+         */
+        void clearDirty(uint8_t index);
+
+        /**
+         * @brief Clear dirty flags of all registers
+         * 
+         */
+        void clearDirty();
+
+        /**
+         * @brief Get current register pointer
+         * 
+         * @return uint8_t Index of the register accessed next
+         */
+        uint8_t getPointer();
+
+        /**
+         * @brief Function to be called in TWI Interrupt Service Routine
+         * 
+         */
+        void interruptVectorRoutine();
+    };
+}
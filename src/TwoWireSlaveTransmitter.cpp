@@ -1,55 +1,207 @@
 #include "TwoWireSlaveTransmitter.hpp"
 
 #include "TwoWireCore.hpp"
+#include "TwoWireStatusTable.hpp"
+#include "TwoWireStatistics.hpp"
+#include "TwoWireTrace.hpp"
 
-#include <compat/twi.h>
+#include "TwoWireRegisters.hpp"
+#include <util/atomic.h>
 
 using namespace TwoWire;
 
 SlaveTransmitter::SlaveTransmitter(const uint8_t *data, size_t size)
-    : data(data), size(size), count(0)
+    : data(data), size(size), count(0), generator(nullptr), chunkGenerator(nullptr), context(nullptr),
+      chunk(nullptr), chunkSize(0), chunkLength(0), chunkPosition(0), ended(false),
+      snapshots(nullptr), published(0), streaming(0), writing(0)
 {
 }
 
+SlaveTransmitter::SlaveTransmitter(Generator generator, void *context)
+    : SlaveTransmitter((const uint8_t *)nullptr, 0)
+{
+    this->generator = generator;
+    this->context = context;
+}
+
+SlaveTransmitter::SlaveTransmitter(ChunkGenerator generator, uint8_t *chunk, size_t size, void *context)
+    : SlaveTransmitter((const uint8_t *)nullptr, 0)
+{
+    this->chunkGenerator = generator;
+    this->chunk = chunk;
+    this->chunkSize = size;
+    this->context = context;
+}
+
 SlaveTransmitter::SlaveTransmitter()
-    : data(nullptr), size(0), count(0)
+    : SlaveTransmitter((const uint8_t *)nullptr, 0)
+{
+}
+
+void SlaveTransmitter::_restart()
 {
+    count = 0;
+    chunkLength = 0;
+    chunkPosition = 0;
+    ended = false;
+}
+
+bool SlaveTransmitter::_next(uint8_t &data)
+{
+    if (generator != nullptr)
+    {
+        data = generator(count, context);
+    }
+    else if (chunkGenerator != nullptr)
+    {
+        if (chunkPosition == chunkLength)
+        {
+            // Refill the chunk buffer
+            chunkLength = chunkGenerator(chunk, chunkSize, count, context);
+            chunkPosition = 0;
+            if (chunkLength == 0)
+                return false;
+        }
+        data = chunk[chunkPosition];
+        chunkPosition++;
+    }
+    else if (count < size)
+    {
+        data = this->data[count];
+    }
+    else
+    {
+        return false;
+    }
+    count++;
+    return true;
 }
 
 void SlaveTransmitter::transmitDataAgain()
 {
-    this->count = 0;
+    _restart();
 }
 
 void SlaveTransmitter::transmitData(const uint8_t *data, size_t size)
 {
-    this->data = data;
-    this->size = size;
-    this->count = 0;
+    // Generator pointers can't be torn by the interrupt
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        this->data = data;
+        this->size = size;
+        generator = nullptr;
+        chunkGenerator = nullptr;
+        snapshots = nullptr;
+        _restart();
+    }
+}
+
+void SlaveTransmitter::transmitGenerated(Generator generator, void *context)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        this->generator = generator;
+        this->chunkGenerator = nullptr;
+        this->context = context;
+        snapshots = nullptr;
+        _restart();
+    }
+}
+
+void SlaveTransmitter::transmitGenerated(ChunkGenerator generator, uint8_t *chunk, size_t size, void *context)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        this->generator = nullptr;
+        this->chunkGenerator = generator;
+        this->chunk = chunk;
+        this->chunkSize = size;
+        this->context = context;
+        snapshots = nullptr;
+        _restart();
+    }
+}
+
+void SlaveTransmitter::transmitSnapshots(uint8_t *storage, size_t size)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        generator = nullptr;
+        chunkGenerator = nullptr;
+        snapshots = storage;
+        published = 0;
+        streaming = 0;
+        data = storage;
+        this->size = size;
+        _restart();
+    }
+}
+
+uint8_t *SlaveTransmitter::beginSnapshot()
+{
+    // Snapshot that is neither published nor streamed
+    // (streamed snapshot can only change to the published one)
+    uint8_t p = published;
+    uint8_t s = streaming;
+    writing = 0;
+    while (writing == p || writing == s)
+        writing++;
+    return snapshots + writing * size;
+}
+
+void SlaveTransmitter::publishSnapshot()
+{
+    MEMORY_BARRIER();
+    published = writing;
+}
+
+void SlaveTransmitter::publishSnapshot(const uint8_t *data)
+{
+    uint8_t *snapshot = beginSnapshot();
+    for (size_t i = 0; i < size; i++)
+        snapshot[i] = data[i];
+    publishSnapshot();
 }
 
 bool SlaveTransmitter::isDataTransmitted()
 {
+    if (generator != nullptr || chunkGenerator != nullptr)
+        return ended;
     return size == count;
 }
 
 void SlaveTransmitter::interruptVectorRoutine()
 {
-    switch (TW_STATUS)
+    uint8_t status = TW_STATUS;
+    Trace::_record(status);
+    Statistics::_countSlaveStatus(status);
+    switch (StatusTable::getSlaveBasicStatus(status))
     {
-    case TW_ST_SLA_ACK:
-    case TW_ST_ARB_LOST_SLA_ACK:
-        if (count < size)
+    case Slave::BasicStatus::AddressedAsTransmitter:
+        // Generated data starts over with every read
+        if (generator != nullptr || chunkGenerator != nullptr)
+        {
+            _restart();
+        }
+        // Switch to the newest snapshot only between reads
+        else if (snapshots != nullptr)
+        {
+            streaming = published;
+            data = snapshots + streaming * size;
+            _restart();
+        }
+        else if (count < size)
         {
             count = 0;
         }
         [[fallthrough]];
-    case TW_ST_DATA_ACK:
-        if (count < size)
+    case Slave::BasicStatus::SentDataAccepted:
+    {
+        uint8_t data;
+        if (_next(data))
         {
-            TWDR = data[count];
+            TWDR = data;
             TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
-            count++;
         }
         else
         {
@@ -57,6 +209,16 @@ void SlaveTransmitter::interruptVectorRoutine()
             TWCR = TWCR_W(_BV(TWINT));
         }
         break;
-    // Ignore NACK or LAST_DATA
+    }
+    case Slave::BasicStatus::SentDataDeclined:
+    case Slave::BasicStatus::MoreDataRequest:
+        // Master ended the read, let it address us again
+        ended = true;
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWEA));
+        break;
+    default:
+        // Release the bus after bus error
+        StatusTable::applyAction(status);
+        break;
     }
 }
@@ -7,10 +7,47 @@ namespace TwoWire
 {
     class SlaveTransmitter
     {
+    public:
+        /**
+         * @brief Function called (from the TWI interrupt) for each byte the master reads
+         * 
+         * @param index Index of the byte in the current read
+         * @param context User provided context
+         * @return uint8_t Byte to transmit
+         */
+        using Generator = uint8_t (*)(size_t index, void *context);
+
+        /**
+         * @brief Function called (from the TWI interrupt) when the chunk buffer runs empty
+         * 
+         * @param data Chunk buffer to fill
+         * @param size Size of the chunk buffer
+         * @param index Index of the first byte in the current read
+         * @param context User provided context
+         * @return size_t Number of bytes produced (0 ends the data)
+         */
+        using ChunkGenerator = size_t (*)(uint8_t *data, size_t size, size_t index, void *context);
+
     private:
         const uint8_t* data;
         size_t size;
         size_t count;
+        Generator generator;
+        ChunkGenerator chunkGenerator;
+        void *context;
+        uint8_t *chunk;
+        size_t chunkSize;
+        size_t chunkLength;
+        size_t chunkPosition;
+        volatile bool ended;
+        uint8_t *snapshots;
+        volatile uint8_t published;
+        volatile uint8_t streaming;
+        uint8_t writing;
+
+        void _restart();
+
+        bool _next(uint8_t &data);
 
     public:
         /**
@@ -22,6 +59,26 @@ namespace TwoWire
          */
         SlaveTransmitter(const uint8_t *data, size_t size);
 
+        /**
+         * @brief Construct Slave trasmitter generating data byte by byte
+         *  (data is computed at the moment the master reads it, every read starts at index 0)
+         * 
+         * @param generator Function generating the bytes
+         * @param context Context passed to the generator
+         */
+        SlaveTransmitter(Generator generator, void *context);
+
+        /**
+         * @brief Construct Slave trasmitter generating data in chunks
+         *  (chunk buffer is refilled from the TWI interrupt, every read starts at index 0)
+         * 
+         * @param generator Function filling the chunk buffer
+         * @param chunk Chunk buffer
+         * @param size Size of the chunk buffer
+         * @param context Context passed to the generator
+         */
+        SlaveTransmitter(ChunkGenerator generator, uint8_t *chunk, size_t size, void *context);
+
         /**
          * @brief Construct Slave trasmitter
          *  (data location has to be specified before the class is able to trasmit any data)
@@ -43,8 +100,69 @@ namespace TwoWire
          */
         void transmitData(const uint8_t *data, size_t size);
 
+        /**
+         * @brief Trasmit data generated byte by byte
+         * 
+         * @param generator Function generating the bytes
+         * @param context Context passed to the generator
+         */
+        void transmitGenerated(Generator generator, void *context);
+
+        /**
+         * @brief Trasmit data generated in chunks
+         * 
+         * @param generator Function filling the chunk buffer
+         * @param chunk Chunk buffer
+         * @param size Size of the chunk buffer
+         * @param context Context passed to the generator
+         */
+        void transmitGenerated(ChunkGenerator generator, uint8_t *chunk, size_t size, void *context);
+
+        /**
+         * @brief Get size of the storage needed for snapshots
+         * 
+         * @param size Size of a snapshot
+         * @return size_t Size of the storage (three snapshots)
+         */
+        static constexpr size_t getSnapshotStorageSize(size_t size)
+        {
+            return 3 * size;
+        }
+
+        /**
+         * @brief Trasmit published snapshots
+         *  (every read streams the newest snapshot published before the address match, without tearing)
+         * 
+         * @param storage Storage for the snapshots (getSnapshotStorageSize(size) bytes)
+         * @param size Size of a snapshot
+         */
+        void transmitSnapshots(uint8_t *storage, size_t size);
+
+        /**
+         * @brief Get snapshot to write the next version to
+         *  (never streamed by the ISR until published, interrupts stay enabled)
+         * 
+         * @return uint8_t* Snapshot to write
+         */
+        uint8_t *beginSnapshot();
+
+        /**
+         * @brief Publish the snapshot returned by beginSnapshot
+         *  (following reads stream it)
+         * 
+         */
+        void publishSnapshot();
+
+        /**
+         * @brief Copy data to a new snapshot and publish it
+         * 
+         * @param data Data of the snapshot (size of a snapshot)
+         */
+        void publishSnapshot(const uint8_t *data);
+
         /**
          * @brief Check whether the storage location has been trasmitted
+         *  (generated data is trasmitted once the master ends its read)
          * 
          * @return true Storage location has been trasmitted
          * @return false Waiting for connections
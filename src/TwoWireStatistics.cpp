@@ -0,0 +1,204 @@
+#include "TwoWireStatistics.hpp"
+
+#ifdef TWOWIRE_STATISTICS
+
+#include "TwoWireRegisters.hpp"
+#include <Arduino.h>
+#include <util/atomic.h>
+#include <string.h>
+
+using namespace TwoWire;
+
+namespace
+{
+    // Tracked addresses and the entry of the others
+    Statistics::AddressStatistics addresses[TWOWIRE_STATISTICS_ADDRESSES + 1];
+    uint8_t addressCount = 0;
+    Statistics::SlaveStatistics slave;
+    Statistics::Histogram histograms[Statistics::TRANSACTION_TYPES];
+
+    // Transaction in progress
+    uint32_t masterStart;
+    uint32_t masterBytes;
+    uint32_t slaveStart;
+    // Slave transaction type + 1 (0 if none)
+    uint8_t slaveType = 0;
+
+    void _increment(uint16_t &counter)
+    {
+        if (counter < UINT16_MAX)
+            counter++;
+    }
+
+    void _record(Statistics::Transaction type, uint32_t start)
+    {
+        _increment(histograms[(uint8_t)type].buckets[Statistics::getBucket(micros() - start)]);
+    }
+
+    Statistics::AddressStatistics &_findAddress(uint8_t address)
+    {
+        for (uint8_t i = 0; i < addressCount; i++)
+        {
+            if (addresses[i].address == address)
+                return addresses[i];
+        }
+        if (addressCount < TWOWIRE_STATISTICS_ADDRESSES)
+        {
+            addresses[addressCount].address = address;
+            return addresses[addressCount++];
+        }
+        addresses[TWOWIRE_STATISTICS_ADDRESSES].address = Statistics::OTHER_ADDRESSES;
+        return addresses[TWOWIRE_STATISTICS_ADDRESSES];
+    }
+
+    void _endSlaveTransaction()
+    {
+        if (slaveType == 0)
+            return;
+        auto type = (Statistics::Transaction)(slaveType - 1);
+        _increment(type == Statistics::Transaction::SlaveReceive ? slave.receptions : slave.transmissions);
+        _record(type, slaveStart);
+        slaveType = 0;
+    }
+
+    void _beginSlaveTransaction(Statistics::Transaction type)
+    {
+        // Repeated START without STOP in between
+        _endSlaveTransaction();
+        slaveStart = micros();
+        slaveType = (uint8_t)type + 1;
+    }
+}
+
+bool Statistics::getAddressStatistics(uint8_t address, AddressStatistics &statistics)
+{
+    if (address == OTHER_ADDRESSES)
+        return getAddressStatisticsAt(TWOWIRE_STATISTICS_ADDRESSES, statistics);
+    for (uint8_t i = 0; i < addressCount; i++)
+    {
+        if (addresses[i].address == address)
+            return getAddressStatisticsAt(i, statistics);
+    }
+    return false;
+}
+
+bool Statistics::getAddressStatisticsAt(uint8_t index, AddressStatistics &statistics)
+{
+    bool used = index < addressCount ||
+        (index == TWOWIRE_STATISTICS_ADDRESSES && addresses[index].transactions > 0);
+    if (used)
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            statistics = addresses[index];
+        }
+    }
+    return used;
+}
+
+Statistics::SlaveStatistics Statistics::getSlaveStatistics()
+{
+    SlaveStatistics s;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        s = slave;
+    }
+    return s;
+}
+
+void Statistics::getHistogram(Transaction type, Histogram &histogram)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        histogram = histograms[(uint8_t)type];
+    }
+}
+
+uint8_t Statistics::getBucket(uint32_t latency)
+{
+    // Number of significant bits
+    uint8_t bucket = 0;
+    while (latency > 0 && bucket < HISTOGRAM_BUCKETS - 1)
+    {
+        latency >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void Statistics::reset()
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        memset(addresses, 0, sizeof(addresses));
+        addressCount = 0;
+        memset(&slave, 0, sizeof(slave));
+        memset(histograms, 0, sizeof(histograms));
+        slaveType = 0;
+    }
+}
+
+void Statistics::_beginTransaction()
+{
+    masterStart = micros();
+    masterBytes = 0;
+}
+
+void Statistics::_countByte()
+{
+    masterBytes++;
+}
+
+void Statistics::_endTransaction(Transaction type, uint8_t address, MasterPrimitives::Status status, uint8_t attempts)
+{
+    // Master statistics are written and read by the main loop only
+    auto &a = _findAddress(address);
+    _increment(a.transactions);
+    a.bytes += masterBytes;
+    uint32_t retries = (uint32_t)a.retries + attempts - 1;
+    a.retries = retries < UINT16_MAX ? retries : UINT16_MAX;
+    _increment(a.statuses[(uint8_t)status]);
+    _record(type, masterStart);
+}
+
+void Statistics::_countSlaveStatus(uint8_t status)
+{
+    switch (status)
+    {
+    case TW_SR_SLA_ACK:
+    case TW_SR_GCALL_ACK:
+    case TW_SR_ARB_LOST_SLA_ACK:
+    case TW_SR_ARB_LOST_GCALL_ACK:
+        _beginSlaveTransaction(Transaction::SlaveReceive);
+        break;
+    case TW_ST_SLA_ACK:
+    case TW_ST_ARB_LOST_SLA_ACK:
+        _beginSlaveTransaction(Transaction::SlaveTransmit);
+        break;
+    case TW_SR_DATA_ACK:
+    case TW_SR_GCALL_DATA_ACK:
+        slave.bytesReceived++;
+        break;
+    case TW_SR_DATA_NACK:
+    case TW_SR_GCALL_DATA_NACK:
+        slave.bytesReceived++;
+        _endSlaveTransaction();
+        break;
+    case TW_ST_DATA_ACK:
+        slave.bytesTransmitted++;
+        break;
+    case TW_ST_DATA_NACK:
+    case TW_ST_LAST_DATA:
+        slave.bytesTransmitted++;
+        _endSlaveTransaction();
+        break;
+    case TW_SR_STOP:
+    case TW_BUS_ERROR:
+        _endSlaveTransaction();
+        break;
+    default:
+        break;
+    }
+}
+
+#endif
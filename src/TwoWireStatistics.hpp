@@ -0,0 +1,140 @@
+#pragma once
+
+#include "TwoWireMasterPrimitives.hpp"
+#include "TwoWireTransaction.hpp"
+
+// Statistics are collected only if TWOWIRE_STATISTICS is defined for the whole build (including the library sources),
+// otherwise the hooks below are empty and compile to nothing
+#ifdef TWOWIRE_STATISTICS
+// Number of slave addresses tracked by the master statistics (the rest is counted together)
+#ifndef TWOWIRE_STATISTICS_ADDRESSES
+#define TWOWIRE_STATISTICS_ADDRESSES 8
+#endif
+#endif
+
+namespace TwoWire
+{
+    namespace Statistics
+    {
+        // Number of transaction types
+        static constexpr uint8_t TRANSACTION_TYPES = (uint8_t)Transaction::SlaveTransmit + 1;
+        // Number of master statuses
+        static constexpr uint8_t STATUS_COUNT = (uint8_t)MasterPrimitives::Status::Unknown + 1;
+        // Bucket 0 counts latencies below 1 us, bucket i latencies from 2^(i-1) us below 2^i us, the last one everything longer
+        static constexpr uint8_t HISTOGRAM_BUCKETS = 16;
+        // Address of the entry counting slave addresses that didn't fit the table
+        static constexpr uint8_t OTHER_ADDRESSES = 0x80;
+
+        struct AddressStatistics
+        {
+            // Slave address (OTHER_ADDRESSES for addresses that didn't fit the table)
+            uint8_t address;
+            // Number of transactions
+            uint16_t transactions;
+            // Number of data bytes transferred (including failed attempts)
+            uint32_t bytes;
+            // Number of repeated attempts
+            uint16_t retries;
+            // Number of transactions per outcome (indexed by MasterPrimitives::Status, Timeout included)
+            uint16_t statuses[STATUS_COUNT];
+        };
+
+        struct SlaveStatistics
+        {
+            // Number of transactions as slave receiver
+            uint16_t receptions;
+            // Number of transactions as slave transmitter
+            uint16_t transmissions;
+            // Number of bytes received
+            uint32_t bytesReceived;
+            // Number of bytes transmitted
+            uint32_t bytesTransmitted;
+        };
+
+        struct Histogram
+        {
+            // Number of transactions per latency bucket (counters saturate)
+            uint16_t buckets[HISTOGRAM_BUCKETS];
+        };
+
+#ifdef TWOWIRE_STATISTICS
+        /**
+         * @brief Get statistics of transactions with the slave address
+         *  (copied atomically, safe to call from the main loop)
+         *
+         * @param address Slave address (OTHER_ADDRESSES for addresses that didn't fit the table)
+         * @param statistics Where to copy the statistics
+         * @return true Address was found
+         * @return false Address had no transaction
+         */
+        bool getAddressStatistics(uint8_t address, AddressStatistics &statistics);
+
+        /**
+         * @brief Get statistics of the table entry
+         *  (entries are used in order of the first transaction with the address)
+         *
+         * @param index Index of the entry (0 to TWOWIRE_STATISTICS_ADDRESSES, the last one is OTHER_ADDRESSES)
+         * @param statistics Where to copy the statistics
+         * @return true Entry is used
+         * @return false Entry is unused or out of range
+         */
+        bool getAddressStatisticsAt(uint8_t index, AddressStatistics &statistics);
+
+        /**
+         * @brief Get statistics of the slave routines
+         *
+         * @return SlaveStatistics Slave statistics
+         */
+        SlaveStatistics getSlaveStatistics();
+
+        /**
+         * @brief Get latency histogram of the transaction type
+         *  (master latency includes retries and backoff, slave latency is from the address to the end of the transaction)
+         *
+         * @param type Transaction type
+         * @param histogram Where to copy the histogram
+         */
+        void getHistogram(Transaction type, Histogram &histogram);
+
+        /**
+         * @brief Get latency bucket
+         *
+         * @param latency Latency in microseconds
+         * @return uint8_t Index of the histogram bucket
+         */
+        uint8_t getBucket(uint32_t latency);
+
+        /**
+         * @brief Reset all statistics
+         *
+         */
+        void reset();
+
+        // Hooks called by the library
+
+        void _beginTransaction();
+
+        void _countByte();
+
+        void _endTransaction(Transaction type, uint8_t address, MasterPrimitives::Status status, uint8_t attempts);
+
+        void _countSlaveStatus(uint8_t status);
+#else
+        inline void _beginTransaction()
+        {
+        }
+
+        inline void _countByte()
+        {
+        }
+
+        inline void _endTransaction(Transaction, uint8_t, MasterPrimitives::Status, uint8_t)
+        {
+        }
+
+        inline void _countSlaveStatus(uint8_t)
+        {
+        }
+#endif
+    }
+}
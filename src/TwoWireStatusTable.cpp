@@ -0,0 +1,129 @@
+#include "TwoWireStatusTable.hpp"
+
+#include "TwoWireRegisters.hpp"
+
+using namespace TwoWire;
+
+using MStatus = MasterPrimitives::Status;
+using SStatus = Slave::Status;
+using SBasicStatus = Slave::BasicStatus;
+using Action = StatusTable::Action;
+
+// Indexed by TW_STATUS >> 3
+static const uint16_t table[32] PROGMEM = {
+    // TW_BUS_ERROR
+    StatusTable::entry(MStatus::Error, SStatus::Error, SBasicStatus::Error, Action::Stop),
+    // TW_START
+    StatusTable::entry(MStatus::Success, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    // TW_REP_START
+    StatusTable::entry(MStatus::Success, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    // TW_MT_SLA_ACK
+    StatusTable::entry(MStatus::Success, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    // TW_MT_SLA_NACK
+    StatusTable::entry(MStatus::AddressNACK, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    // TW_MT_DATA_ACK
+    StatusTable::entry(MStatus::Success, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    // TW_MT_DATA_NACK
+    StatusTable::entry(MStatus::DataNACK, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    // TW_MT_ARB_LOST, TW_MR_ARB_LOST (no need to stop when arbitration lost)
+    StatusTable::entry(MStatus::BusLost, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    // TW_MR_SLA_ACK
+    StatusTable::entry(MStatus::Success, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    // TW_MR_SLA_NACK
+    StatusTable::entry(MStatus::AddressNACK, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    // TW_MR_DATA_ACK
+    StatusTable::entry(MStatus::Success, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    // TW_MR_DATA_NACK
+    StatusTable::entry(MStatus::Success, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    // TW_SR_SLA_ACK
+    StatusTable::entry(MStatus::Unknown, SStatus::DirectlyAddressedAsReceiver, SBasicStatus::AddressedAsReceiver, Action::None),
+    // TW_SR_ARB_LOST_SLA_ACK
+    StatusTable::entry(MStatus::AddressedAsSlave, SStatus::BusLostDirectlyAddressedAsReceiver, SBasicStatus::AddressedAsReceiver, Action::None),
+    // TW_SR_GCALL_ACK
+    StatusTable::entry(MStatus::Unknown, SStatus::GeneralCallAddressedAsReceiver, SBasicStatus::AddressedAsReceiver, Action::None),
+    // TW_SR_ARB_LOST_GCALL_ACK
+    StatusTable::entry(MStatus::AddressedAsSlave, SStatus::BusLostGeneralCallAdressedAsReceiver, SBasicStatus::AddressedAsReceiver, Action::None),
+    // TW_SR_DATA_ACK
+    StatusTable::entry(MStatus::Unknown, SStatus::DirectDataReceived, SBasicStatus::DataReceived, Action::None),
+    // TW_SR_DATA_NACK
+    StatusTable::entry(MStatus::Unknown, SStatus::DirectLastDataReceived, SBasicStatus::LastDataReceived, Action::Acknowledge),
+    // TW_SR_GCALL_DATA_ACK
+    StatusTable::entry(MStatus::Unknown, SStatus::GeneralCallDataReceived, SBasicStatus::DataReceived, Action::None),
+    // TW_SR_GCALL_DATA_NACK
+    StatusTable::entry(MStatus::Unknown, SStatus::GeneralCallLastDataReceived, SBasicStatus::LastDataReceived, Action::Acknowledge),
+    // TW_SR_STOP
+    StatusTable::entry(MStatus::Unknown, SStatus::SignalReceived, SBasicStatus::SignalReceived, Action::Acknowledge),
+    // TW_ST_SLA_ACK
+    StatusTable::entry(MStatus::Unknown, SStatus::DirectlyAddressedAsTransmitter, SBasicStatus::AddressedAsTransmitter, Action::None),
+    // TW_ST_ARB_LOST_SLA_ACK
+    StatusTable::entry(MStatus::AddressedAsSlave, SStatus::BusLostDirectlyAddressedAsTransmitter, SBasicStatus::AddressedAsTransmitter, Action::None),
+    // TW_ST_DATA_ACK
+    StatusTable::entry(MStatus::Unknown, SStatus::SentDataAccepted, SBasicStatus::SentDataAccepted, Action::None),
+    // TW_ST_DATA_NACK
+    StatusTable::entry(MStatus::Unknown, SStatus::SentDataDeclined, SBasicStatus::SentDataDeclined, Action::Acknowledge),
+    // TW_ST_LAST_DATA
+    StatusTable::entry(MStatus::Unknown, SStatus::MoreDataRequest, SBasicStatus::MoreDataRequest, Action::Acknowledge),
+    // 0xD0 - 0xF0 (unused)
+    StatusTable::entry(MStatus::Unknown, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    StatusTable::entry(MStatus::Unknown, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    StatusTable::entry(MStatus::Unknown, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    StatusTable::entry(MStatus::Unknown, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    StatusTable::entry(MStatus::Unknown, SStatus::Unknown, SBasicStatus::Unknown, Action::None),
+    // TW_NO_INFO
+    StatusTable::entry(MStatus::Unknown, SStatus::NoStatus, SBasicStatus::NoStatus, Action::None),
+};
+
+uint16_t StatusTable::get(uint8_t status)
+{
+    return pgm_read_word(&table[status >> 3]);
+}
+
+MStatus StatusTable::getMasterStatus(uint8_t status)
+{
+    return (MStatus)((get(status) >> 9) & 0x07);
+}
+
+SStatus StatusTable::getSlaveStatus(uint8_t status)
+{
+    return (SStatus)(get(status) & 0x1F);
+}
+
+SBasicStatus StatusTable::getSlaveBasicStatus(uint8_t status)
+{
+    return (SBasicStatus)((get(status) >> 5) & 0x0F);
+}
+
+Action StatusTable::getAction(uint8_t status)
+{
+    return (Action)((get(status) >> 12) & 0x03);
+}
+
+bool StatusTable::applyAction(uint8_t status)
+{
+    switch (getAction(status))
+    {
+    case Action::Acknowledge:
+        TWCR = TWCR_W(_BV(TWINT));
+        return true;
+    case Action::Stop:
+        TWCR = TWCR_W(_BV(TWINT) | _BV(TWSTO));
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool StatusTable::endsSlaveTransaction(uint8_t status)
+{
+    switch (getSlaveBasicStatus(status))
+    {
+    case Slave::BasicStatus::SignalReceived:
+    case Slave::BasicStatus::LastDataReceived:
+    case Slave::BasicStatus::SentDataDeclined:
+    case Slave::BasicStatus::MoreDataRequest:
+    case Slave::BasicStatus::Error:
+        return true;
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "TwoWireMasterPrimitives.hpp"
+#include "TwoWireSlave.hpp"
+
+namespace TwoWire
+{
+    namespace StatusTable
+    {
+        enum class Action : int8_t
+        {
+            // Status has to be handled by the caller
+            None,
+            // Clear TWINT (keeping TWEA)
+            Acknowledge,
+            // Clear TWINT and release the bus with STOP
+            Stop
+        };
+
+        /**
+         * @brief Encode table entry
+         *  (slave status in bits 0-4, basic slave status in bits 5-8, master status in bits 9-11, action in bits 12-13)
+         *
+         * @param master Meaning of the status to the master
+         * @param slave Meaning of the status to the slave
+         * @param basic Basic meaning of the status to the slave
+         * @param action Required TWCR follow-up action
+         * @return uint16_t Table entry
+         */
+        constexpr uint16_t entry(MasterPrimitives::Status master, Slave::Status slave, Slave::BasicStatus basic, Action action)
+        {
+            return (uint16_t)slave | ((uint16_t)basic << 5) | ((uint16_t)master << 9) | ((uint16_t)action << 12);
+        }
+
+        static_assert((uint8_t)Slave::Status::Unknown < 32, "Slave status does not fit the table entry");
+        static_assert((uint8_t)Slave::BasicStatus::Unknown < 16, "Basic slave status does not fit the table entry");
+        static_assert((uint8_t)MasterPrimitives::Status::Unknown < 8, "Master status does not fit the table entry");
+
+        /**
+         * @brief Get table entry of the status
+         *
+         * @param status Hardware status (TW_STATUS)
+         * @return uint16_t Table entry
+         */
+        uint16_t get(uint8_t status);
+
+        /**
+         * @brief Get meaning of the status to the master
+         *
+         * @param status Hardware status (TW_STATUS)
+         * @return MasterPrimitives::Status Master status
+         */
+        MasterPrimitives::Status getMasterStatus(uint8_t status);
+
+        /**
+         * @brief Get meaning of the status to the slave
+         *
+         * @param status Hardware status (TW_STATUS)
+         * @return Slave::Status Slave status
+         */
+        Slave::Status getSlaveStatus(uint8_t status);
+
+        /**
+         * @brief Get basic meaning of the status to the slave
+         *
+         * @param status Hardware status (TW_STATUS)
+         * @return Slave::BasicStatus Basic slave status
+         */
+        Slave::BasicStatus getSlaveBasicStatus(uint8_t status);
+
+        /**
+         * @brief Get TWCR follow-up action required by the status
+         *
+         * @param status Hardware status (TW_STATUS)
+         * @return Action Follow-up action
+         */
+        Action getAction(uint8_t status);
+
+        /**
+         * @brief Execute TWCR follow-up action required by the status
+         *  (statuses without an action are left to the caller)
+         *
+         * @param status Hardware status (TW_STATUS)
+         * @return true Action was executed
+         * @return false Status has no action
+         */
+        bool applyAction(uint8_t status);
+
+        /**
+         * @brief Check whether the slave returns to not addressed mode after the status
+         *  (STOP or repeated START, refused data, last data sent or bus error)
+         *
+         * @param status Hardware status (TW_STATUS)
+         * @return true Slave transaction ends with the status
+         * @return false Slave transaction continues (or the status isn't a slave status)
+         */
+        bool endsSlaveTransaction(uint8_t status);
+    }
+}
@@ -0,0 +1,49 @@
+#include "TwoWireTrace.hpp"
+
+#ifdef TWOWIRE_TRACE
+
+using namespace TwoWire;
+
+Trace::Event Trace::_events[TWOWIRE_TRACE_SIZE];
+uint8_t Trace::_head = 0;
+uint16_t Trace::_count = 0;
+
+size_t Trace::read(Event *events, size_t capacity)
+{
+    size_t size = 0;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        size = _count < TWOWIRE_TRACE_SIZE ? _count : TWOWIRE_TRACE_SIZE;
+        if (size > capacity)
+            size = capacity;
+        // Oldest of the copied events
+        uint8_t i = (uint8_t)((_head - size) & (TWOWIRE_TRACE_SIZE - 1));
+        for (size_t j = 0; j < size; j++)
+        {
+            events[j] = _events[i];
+            i = (uint8_t)((i + 1) & (TWOWIRE_TRACE_SIZE - 1));
+        }
+    }
+    return size;
+}
+
+uint16_t Trace::getCount()
+{
+    uint16_t count = 0;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        count = _count;
+    }
+    return count;
+}
+
+void Trace::clear()
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        _head = 0;
+        _count = 0;
+    }
+}
+
+#endif
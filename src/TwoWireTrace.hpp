@@ -0,0 +1,119 @@
+#pragma once
+
+#include "TwoWireRegisters.hpp"
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Events are recorded only if TWOWIRE_TRACE is defined for the whole build (including the library sources),
+// otherwise the hooks below are empty and compile to nothing
+#ifdef TWOWIRE_TRACE
+#include <Arduino.h>
+#include <util/atomic.h>
+// Number of events kept (power of two, at most 256), older events are overwritten
+#ifndef TWOWIRE_TRACE_SIZE
+#define TWOWIRE_TRACE_SIZE 64
+#endif
+// Length of a timestamp tick in nanoseconds (Timer0 of the Arduino core counts every 64 CPU cycles),
+// define TWOWIRE_TRACE_CLOCK() returning uint16_t ticks along with it to use another clock
+#ifndef TWOWIRE_TRACE_TICK_NS
+#define TWOWIRE_TRACE_TICK_NS (64000000000ULL / F_CPU)
+#endif
+#ifndef TWOWIRE_TRACE_CLOCK
+extern volatile unsigned long timer0_overflow_count;
+#endif
+#endif
+
+namespace TwoWire
+{
+    namespace Trace
+    {
+        struct Event
+        {
+            // TW_STATUS of the TWINT event or one of the markers below
+            uint8_t status;
+            // TWDR at the event (received or sent byte, SLA+R/W after addressing)
+            uint8_t data;
+            // Timestamp in ticks of TWOWIRE_TRACE_TICK_NS (wraps around)
+            uint16_t time;
+        };
+
+        // Markers use the prescaler bits which are never part of TW_STATUS
+        // Blocking master gave up waiting for TWINT
+        static constexpr uint8_t TIMEOUT = 0x01;
+        // STOP was requested by the master (it raises no TWINT)
+        static constexpr uint8_t STOP = 0x02;
+
+#ifdef TWOWIRE_TRACE
+        static_assert(TWOWIRE_TRACE_SIZE > 0 && TWOWIRE_TRACE_SIZE <= 256 && (TWOWIRE_TRACE_SIZE & (TWOWIRE_TRACE_SIZE - 1)) == 0,
+            "TwoWire trace size has to be a power of two up to 256");
+
+        // Length of a timestamp tick in nanoseconds
+        static constexpr uint32_t TICK_NS = TWOWIRE_TRACE_TICK_NS;
+
+        extern Event _events[TWOWIRE_TRACE_SIZE];
+        extern uint8_t _head;
+        extern uint16_t _count;
+
+        /**
+         * @brief Copy the recorded events, oldest first
+         *  (copied atomically, safe to call from the main loop)
+         *
+         * @param events Where to copy the events
+         * @param capacity Maximum number of events to copy (the newest ones are kept)
+         * @return size_t Number of events copied
+         */
+        size_t read(Event *events, size_t capacity);
+
+        /**
+         * @brief Get number of events recorded since the last clear
+         *  (saturates, events beyond TWOWIRE_TRACE_SIZE have overwritten older ones)
+         *
+         * @return uint16_t Number of events
+         */
+        uint16_t getCount();
+
+        /**
+         * @brief Drop all recorded events
+         *
+         */
+        void clear();
+
+        inline uint16_t _clock()
+        {
+#ifdef TWOWIRE_TRACE_CLOCK
+            return TWOWIRE_TRACE_CLOCK();
+#else
+            // micros() is too slow for the interrupt, Timer0 and its overflow count are read directly
+            uint8_t ticks = TCNT0;
+            uint8_t overflows = (uint8_t)timer0_overflow_count;
+            // Overflow the timer interrupt didn't count yet
+            if ((TIFR0 & _BV(TOV0)) && ticks < 255)
+                overflows++;
+            return (uint16_t)overflows << 8 | ticks;
+#endif
+        }
+
+        // Hooks called by the library (a few cycles each)
+
+        inline void _record(uint8_t status)
+        {
+            // Blocking master records from the main loop, slave routines from the interrupt
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                uint8_t i = _head;
+                _events[i].status = status;
+                _events[i].data = TWDR;
+                _events[i].time = _clock();
+                _head = (uint8_t)((i + 1) & (TWOWIRE_TRACE_SIZE - 1));
+                if (_count < UINT16_MAX)
+                    _count++;
+            }
+        }
+#else
+        inline void _record(uint8_t)
+        {
+        }
+#endif
+    }
+}
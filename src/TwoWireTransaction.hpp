@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace TwoWire
+{
+    namespace Statistics
+    {
+        enum class Transaction : uint8_t
+        {
+            // MasterConfig::send
+            Send,
+            // MasterConfig::receive
+            Receive,
+            // MasterConfig::receiveRegister
+            ReceiveRegister,
+            // MasterConfig::writeRegister
+            WriteRegister,
+            // MasterConfig::probe
+            Probe,
+            // Slave routine addressed for writing
+            SlaveReceive,
+            // Slave routine addressed for reading
+            SlaveTransmit
+        };
+    }
+}